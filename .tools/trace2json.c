@@ -0,0 +1,222 @@
+/******************************************************************************
+
+    @file    StateOS: trace2json.c
+    @author  Rajmund Szymanski
+    @date    17.10.2018
+    @brief   Host tool: conversion of the StateOS trace buffer to the chrome trace format.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************
+
+   build:  cc -O2 -o trace2json trace2json.c
+   usage:  trace2json dump.bin > trace.json
+
+   The input is a memory dump containing the Trace object (OS_TRACE > 0),
+   e.g. made by the debugger: dump binary value dump.bin Trace
+   The dump may contain any data before the Trace object (e.g. whole RAM).
+   Both little and big endian targets with 32 or 64-bit pointers are supported.
+   The output can be opened with chrome://tracing or https://ui.perfetto.dev
+   Every processor is shown as a thread with slices of the running tasks.
+
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+// must match the definitions in StateOS/kernel/ostrace.h
+
+#define TRC_MAGIC    0x43525453UL
+
+#define TRC_SWITCH   0x01
+#define TRC_WAKEUP   0x02
+#define TRC_BLOCK    0x03
+#define TRC_TIMER    0x04
+#define TRC_USER     0x80
+
+#define TRC_HEAD       24 // size of the trace buffer header (in bytes)
+#define TRC_CPUS       32 // maximum number of processors
+
+/* -------------------------------------------------------------------------- */
+
+static const uint8_t *buf;
+static int big; // big endian target
+
+static
+uint64_t get( size_t pos, size_t len )
+{
+	uint64_t val = 0;
+	size_t   i;
+
+	for (i = 0; i < len; i++)
+		val |= (uint64_t)buf[pos + (big ? len - 1 - i : i)] << (8 * i);
+
+	return val;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+long find( size_t size )
+{
+	size_t pos;
+
+	for (pos = 0; pos + TRC_HEAD <= size; pos += 4)
+	{
+		big = 0; if (get(pos, 4) == TRC_MAGIC) return (long) pos;
+		big = 1; if (get(pos, 4) == TRC_MAGIC) return (long) pos;
+	}
+
+	return -1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void event( const char *ph, const char *name, unsigned cpu, double ts )
+{
+	printf(",\n{\"name\":\"%s\",\"ph\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", name, ph, cpu, ts);
+}
+
+/* -------------------------------------------------------------------------- */
+
+int main( int argc, char *argv[] )
+{
+	FILE    *file;
+	uint8_t *data;
+	size_t   size, rsz, ptr, cnt, num, i;
+	uint32_t freq, cpus, head, time = 0;
+	uint64_t now = 0;
+	uint64_t run[TRC_CPUS] = { 0 }; // task running on the processor
+	long     pos;
+	char     name[64];
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: %s dump.bin > trace.json\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	file = fopen(argv[1], "rb");
+	if (file == NULL)
+	{
+		perror(argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	fseek(file, 0, SEEK_END);
+	size = (size_t) ftell(file);
+	fseek(file, 0, SEEK_SET);
+	data = malloc(size + 1);
+	if (data == NULL || fread(data, 1, size, file) != size)
+	{
+		fprintf(stderr, "%s: read error\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	fclose(file);
+	buf = data;
+
+	pos = find(size);
+	if (pos < 0)
+	{
+		fprintf(stderr, "%s: trace buffer not found\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	rsz  = (size_t) get((size_t) pos +  4, 4);
+	cnt  = (size_t) get((size_t) pos +  8, 4);
+	freq = (uint32_t) get((size_t) pos + 12, 4);
+	cpus = (uint32_t) get((size_t) pos + 16, 4);
+	head = (uint32_t) get((size_t) pos + 20, 4);
+	ptr  = (rsz - 8) / 2;
+
+	if ((ptr != 4 && ptr != 8) || cnt == 0 || (cnt & (cnt - 1)) || freq == 0 || cpus == 0 || cpus > TRC_CPUS ||
+	    (size_t) pos + TRC_HEAD + cnt * rsz > size)
+	{
+		fprintf(stderr, "%s: invalid trace buffer\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	num = head < cnt ? head : cnt;
+
+	printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	for (i = 0; i < cpus; i++)
+	{
+		printf("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"CPU %u\"}}",
+		       i ? "," : "", (unsigned) i, (unsigned) i);
+	}
+
+	for (i = 0; i < num; i++)
+	{
+		size_t   rec = (size_t) pos + TRC_HEAD + ((head - num + i) & (cnt - 1)) * rsz;
+		uint32_t tim = (uint32_t) get(rec,     4);
+		unsigned evt = (unsigned) get(rec + 4, 2);
+		unsigned cpu = (unsigned) get(rec + 6, 2) % cpus;
+		uint64_t obj = get(rec + 8,       ptr);
+		uint64_t tsk = get(rec + 8 + ptr, ptr);
+		double   ts;
+
+		now += i ? (uint32_t)(tim - time) : 0; // the runtime counter can overflow
+		time = tim;
+		ts = (double) now * 1e6 / freq;
+
+		switch (evt)
+		{
+		case TRC_SWITCH:
+			if (run[cpu])
+			{
+				event("E", "", cpu, ts);
+				printf("}");
+			}
+			snprintf(name, sizeof(name), "task 0x%llx", (unsigned long long) tsk);
+			event("B", name, cpu, ts);
+			printf("}");
+			run[cpu] = tsk;
+			continue;
+		case TRC_WAKEUP: snprintf(name, sizeof(name), "wakeup"); break;
+		case TRC_BLOCK:  snprintf(name, sizeof(name), "block");  break;
+		case TRC_TIMER:  snprintf(name, sizeof(name), "timer");  break;
+		default:         snprintf(name, sizeof(name), evt >= TRC_USER ? "user 0x%x" : "event 0x%x", evt); break;
+		}
+
+		event("i", name, cpu, ts);
+		printf(",\"s\":\"t\",\"args\":{\"obj\":\"0x%llx\",\"tsk\":\"0x%llx\"}}", (unsigned long long) obj, (unsigned long long) tsk);
+	}
+
+	for (i = 0; i < cpus; i++)
+	{
+		if (run[i])
+		{
+			event("E", "", (unsigned) i, (double) now * 1e6 / freq);
+			printf("}");
+		}
+	}
+
+	printf("\n]}\n");
+
+	free(data);
+
+	return EXIT_SUCCESS;
+}
@@ -81,7 +81,7 @@ osStatus_t osKernelGetInfo (osVersion_t *version, char *id_buf, uint32_t id_size
 
 osKernelState_t osKernelGetState (void)
 {
-	return osKernelRunning;
+	return sys_getSchedLock() ? osKernelLocked : osKernelRunning;
 }
 
 osStatus_t osKernelStart (void)
@@ -95,18 +95,30 @@ osStatus_t osKernelStart (void)
 
 int32_t osKernelLock (void)
 {
+	int32_t lock;
+
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return (int32_t)osErrorISR;
 
-	return (int32_t) core_set_lock();
+	lock = sys_getSchedLock() ? 1 : 0;
+	if (lock == 0)
+		sys_suspendSched();
+
+	return lock;
 }
 
 int32_t osKernelUnlock (void)
 {
+	int32_t lock;
+
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return (int32_t)osErrorISR;
 
-	return (int32_t) core_clr_lock();
+	lock = sys_getSchedLock() ? 1 : 0;
+	if (lock != 0)
+		sys_resumeSched();
+
+	return lock;
 }
 
 int32_t osKernelRestoreLock (int32_t lock)
@@ -114,19 +126,48 @@ int32_t osKernelRestoreLock (int32_t lock)
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return (int32_t)osErrorISR;
 
-	core_put_lock((lck_t) lock);
+	if (lock != 0)
+		(void) osKernelLock();
+	else
+		(void) osKernelUnlock();
 
-	return lock;
+	return sys_getSchedLock() ? 1 : 0;
 }
 
 uint32_t osKernelSuspend (void)
 {
-	return 0U;
+	cnt_t cnt = 0U;
+
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return 0U;
+
+#if HW_TIMER_SIZE
+	sys_lock();
+	{
+		cnt = core_tmr_delay();
+	}
+	sys_unlock();
+#elif OS_DYNAMIC_TICK
+	sys_lock();
+	{
+		cnt = core_sys_suspend();
+	}
+	sys_unlock();
+#endif
+
+	return cnt > osWaitForever ? osWaitForever : (uint32_t) cnt;
 }
 
 void osKernelResume (uint32_t sleep_ticks)
 {
+	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
+		return;
+
+#if HW_TIMER_SIZE == 0 && OS_DYNAMIC_TICK
+	core_sys_resume(sleep_ticks);
+#else
 	(void) sleep_ticks;
+#endif
 }
 
 uint32_t osKernelGetTickCount (void)
@@ -141,7 +182,9 @@ uint32_t osKernelGetTickFreq (void)
 
 uint32_t osKernelGetSysTimerCount (void)
 {
-#if HW_TIMER_SIZE
+#if OS_TIME_NSEC
+	return (uint32_t) core_clk_time();
+#elif HW_TIMER_SIZE || !defined(SysTick)
 	return sys_time();
 #else
 	uint32_t cnt;
@@ -168,7 +211,9 @@ uint32_t osKernelGetSysTimerCount (void)
 
 uint32_t osKernelGetSysTimerFreq (void)
 {
-#if HW_TIMER_SIZE
+#if OS_TIME_NSEC
+	return RUN_FREQUENCY;
+#elif HW_TIMER_SIZE || !defined(SysTick)
 	return  OS_FREQUENCY;
 #elif (CPU_FREQUENCY)/(OS_FREQUENCY)-1 <= SysTick_LOAD_RELOAD_Msk
 	return CPU_FREQUENCY;
@@ -249,11 +294,13 @@ osThreadId_t osThreadNew (osThreadFunc_t func, void *argument, const osThreadAtt
 	sys_lock();
 	{
 		tsk_init(&thread->tsk, (attr == NULL) ? osPriorityNormal : attr->priority, thread_handler, stack_mem, stack_size);
-		if (attr->cb_mem    == NULL || attr->cb_size    == 0U) thread->tsk.hdr.obj.res = thread;
+		if (attr == NULL || attr->cb_mem    == NULL || attr->cb_size    == 0U) thread->tsk.hdr.obj.res = thread;
 		else
 		if (attr->stack_mem == NULL || attr->stack_size == 0U) thread->tsk.hdr.obj.res = stack_mem;
 		thread->tsk.join = (flags & osThreadJoinable) ? JOINABLE : DETACHED;
+#if OS_TSK_NOTIFY == 0
 		flg_init(&thread->flg, 0);
+#endif
 		thread->flags = flags;
 		thread->name = (attr == NULL) ? NULL : attr->name;
 		thread->func = func;
@@ -313,7 +360,8 @@ osStatus_t osThreadSetPriority (osThreadId_t thread_id, osPriority_t priority)
 
 	sys_lock();
 	{
-		core_tsk_prio(&thread->tsk, thread->tsk.basic = priority);
+		thread->tsk.basic = priority;
+		core_tsk_prio(&thread->tsk, 0);
 	}
 	sys_unlock();
 
@@ -446,11 +494,34 @@ uint32_t osThreadGetStackSpace (osThreadId_t thread_id)
 		return 0U;
 
 	if (&thread->tsk != tsk_this())
-		return (uint32_t) thread->tsk.sp - (uint32_t) thread->tsk.stack;
+		return (uint32_t)((uintptr_t) thread->tsk.sp - (uintptr_t) thread->tsk.stack);
+
+	return (uint32_t)((uintptr_t) port_get_sp() - (uintptr_t) thread->tsk.stack);
+}
+
+#if OS_TASK_RUNTIME
+
+osStatus_t osThreadGetInfo (osThreadId_t thread_id, osThreadInfo_t *info)
+{
+	osThread_t *thread = thread_id;
+
+	if ((thread_id == NULL) || (info == NULL))
+		return osErrorParameter;
+
+	sys_lock();
+	{
+		core_run_account();
+		info->runtime = thread->tsk.runtime;
+		info->idle    = IDLE.runtime;
+		info->total   = System.run;
+	}
+	sys_unlock();
 
-	return (uint32_t) port_get_sp() - (uint32_t) thread->tsk.stack;
+	return osOK;
 }
 
+#endif
+
 uint32_t osThreadGetCount (void)
 {
 	tsk_t   *tsk;
@@ -467,7 +538,7 @@ uint32_t osThreadGetCount (void)
 		for (tsk = IDLE.hdr.next; tsk != &IDLE; tsk = tsk->hdr.next)
 			count++;
 
-		for (tmr = WAIT.hdr.next; tmr != &WAIT; tmr = tmr->hdr.next)
+		for (tmr = core_tmr_next(&WAIT); tmr != &WAIT; tmr = core_tmr_next(tmr))
 			if (tmr->hdr.id == ID_BLOCKED)
 				count++;
 	}
@@ -492,7 +563,7 @@ uint32_t osThreadEnumerate (osThreadId_t *thread_array, uint32_t array_items)
 		for (tsk = IDLE.hdr.next; (tsk != &IDLE) && (count < array_items); tsk = tsk->hdr.next)
 			thread_array[count++] = tsk;
 
-		for (tmr = WAIT.hdr.next; (tmr != &WAIT) && (count < array_items); tmr = tmr->hdr.next)
+		for (tmr = core_tmr_next(&WAIT); (tmr != &WAIT) && (count < array_items); tmr = core_tmr_next(tmr))
 			if (tmr->hdr.id == ID_BLOCKED)
 				thread_array[count++] = tmr;
 	}
@@ -510,7 +581,11 @@ uint32_t osThreadFlagsSet (osThreadId_t thread_id, uint32_t flags)
 	if ((thread_id == NULL) || ((flags & osFlagsError) != 0U))
 		return osFlagsErrorParameter;
 
+#if OS_TSK_NOTIFY
+	return tsk_notify(&thread->tsk, 0, flags, ntfSetBits);
+#else
 	return flg_give(&thread->flg, flags);
+#endif
 }
 
 uint32_t osThreadFlagsClear (uint32_t flags)
@@ -521,7 +596,11 @@ uint32_t osThreadFlagsClear (uint32_t flags)
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return osFlagsErrorISR;
 
+#if OS_TSK_NOTIFY
+	return tsk_notifyClear(&thread->tsk, 0, flags);
+#else
 	return flg_clear(&thread->flg, flags);
+#endif
 }
 
 uint32_t osThreadFlagsGet (void)
@@ -532,20 +611,30 @@ uint32_t osThreadFlagsGet (void)
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return osFlagsErrorISR;
 
+#if OS_TSK_NOTIFY
+	return tsk_notifyGet(&thread->tsk, 0);
+#else
 	return flg_get(&thread->flg);
+#endif
 }
 
 uint32_t osThreadFlagsWait (uint32_t flags, uint32_t options, uint32_t timeout)
 {
+#if OS_TSK_NOTIFY == 0
 	void *tmp = tsk_this(); // because of COSMIC compiler
 	osThread_t *thread = tmp;
+#endif
 
 	if (IS_IRQ_MODE() || IS_IRQ_MASKED())
 		return osFlagsErrorISR;
 	if ((flags & osFlagsError) != 0U)
 		return osFlagsErrorParameter;
 
+#if OS_TSK_NOTIFY
+	switch (tsk_notifyWaitFor(0, flags, options, &flags, timeout))
+#else
 	switch (flg_waitFor(&thread->flg, flags, options, timeout))
+#endif
 	{
 		case E_SUCCESS: return flags;
 		case E_TIMEOUT: return osFlagsErrorTimeout;
@@ -615,7 +704,10 @@ osTimerId_t osTimerNew (osTimerFunc_t func, osTimerType_t type, void *argument,
 	sys_lock();
 	{
 		tmr_init(&timer->tmr, timer_handler);
-		if (attr->cb_mem == NULL || attr->cb_size == 0U) timer->tmr.hdr.obj.res = timer;
+#if OS_TIMER_DAEMON
+		tmr_setDeferred(&timer->tmr, true); // callbacks are executed in the timer thread
+#endif
+		if (attr == NULL || attr->cb_mem == NULL || attr->cb_size == 0U) timer->tmr.hdr.obj.res = timer;
 		timer->flags = flags;
 		timer->name = (attr == NULL) ? NULL : attr->name;
 		timer->func = func;
@@ -718,7 +810,7 @@ osEventFlagsId_t osEventFlagsNew (const osEventFlagsAttr_t *attr)
 	sys_lock();
 	{
 		flg_init(&ef->flg, 0);
-		if (attr->cb_mem == NULL || attr->cb_size == 0U) ef->flg.obj.res = ef;
+		if (attr == NULL || attr->cb_mem == NULL || attr->cb_size == 0U) ef->flg.obj.res = ef;
 		ef->flags = flags;
 		ef->name = (attr == NULL) ? NULL : attr->name;
 	}
@@ -843,7 +935,7 @@ osMutexId_t osMutexNew (const osMutexAttr_t *attr)
 	sys_lock();
 	{
 		mtx_init(&mutex->mtx, mutex_mode(flags), 0);
-		if (attr->cb_mem == NULL || attr->cb_size == 0U) mutex->mtx.obj.res = mutex;
+		if (attr == NULL || attr->cb_mem == NULL || attr->cb_size == 0U) mutex->mtx.obj.res = mutex;
 		mutex->flags = flags;
 		mutex->name = (attr == NULL) ? NULL : attr->name;
 	}
@@ -949,7 +1041,7 @@ osSemaphoreId_t osSemaphoreNew (uint32_t max_count, uint32_t initial_count, cons
 	sys_lock();
 	{
 		sem_init(&semaphore->sem, initial_count, max_count);
-		if (attr->cb_mem == NULL || attr->cb_size == 0U) semaphore->sem.obj.res = semaphore;
+		if (attr == NULL || attr->cb_mem == NULL || attr->cb_size == 0U) semaphore->sem.obj.res = semaphore;
 		semaphore->flags = flags;
 		semaphore->name = (attr == NULL) ? NULL : attr->name;
 	}
@@ -1077,7 +1169,7 @@ osMemoryPoolId_t osMemoryPoolNew (uint32_t block_count, uint32_t block_size, con
 	sys_lock();
 	{
 		mem_init(&mp->mem, block_size, data, size);
-		if (attr->cb_mem == NULL || attr->cb_size == 0U) mp->mem.lst.obj.res = mp;
+		if (attr == NULL || attr->cb_mem == NULL || attr->cb_size == 0U) mp->mem.lst.obj.res = mp;
 		else
 		if (attr->mp_mem == NULL || attr->mp_size == 0U) mp->mem.lst.obj.res = data;
 		mp->flags = flags;
@@ -1251,7 +1343,7 @@ osMessageQueueId_t osMessageQueueNew (uint32_t msg_count, uint32_t msg_size, con
 	sys_lock();
 	{
 		box_init(&mq->box, msg_count, data, msg_size);
-		if (attr->cb_mem == NULL || attr->cb_size == 0U) mq->box.obj.res = mq;
+		if (attr == NULL || attr->cb_mem == NULL || attr->cb_size == 0U) mq->box.obj.res = mq;
 		else
 		if (attr->mq_mem == NULL || attr->mq_size == 0U) mq->box.obj.res = data;
 		mq->flags = flags;
@@ -56,7 +56,9 @@ extern "C" {
 struct __Thread
 {
 	tsk_t          tsk;   // StateOS task object
-	flg_t          flg;   // StateOS flag object
+#if OS_TSK_NOTIFY == 0
+	flg_t          flg;   // StateOS flag object; thread flags are kept in notification slot 0 of the task otherwise
+#endif
 	uint32_t       flags; // attribute bits
 	const char   * name;  // task name
 	osThreadFunc_t func;  // task function
@@ -68,6 +70,23 @@ typedef struct __Thread osThread_t;
 #define osThreadCbSize sizeof(osThread_t)
 #define osThreadStackSize(size) (((((size)?(size):(OS_STACK_SIZE))+7)/8)*8)
 
+#if OS_TASK_RUNTIME
+
+/// Thread runtime information (StateOS extension), in units of the runtime counter
+typedef struct {
+  uint64_t                   runtime;   ///< processor time used by the thread
+  uint64_t                      idle;   ///< processor time used by the idle process
+  uint64_t                     total;   ///< total processor time counted by the kernel
+} osThreadInfo_t;
+
+/// Get runtime information of a thread (StateOS extension).
+/// \param[in]     thread_id     thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+/// \param[out]    info          pointer to buffer for runtime information.
+/// \return status code that indicates the execution status of the function.
+osStatus_t osThreadGetInfo (osThreadId_t thread_id, osThreadInfo_t *info);
+
+#endif
+
 /*---------------------------------------------------------------------------*/
 
 struct __Timer
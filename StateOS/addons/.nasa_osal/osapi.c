@@ -1110,7 +1110,8 @@ int32 OS_TaskSetPriority(uint32 task_id, uint32 new_priority)
 			status = OS_ERR_INVALID_PRIORITY;
 		else
 		{
-			core_tsk_prio(&rec->tsk, rec->tsk.basic = ~new_priority);
+			rec->tsk.basic = ~new_priority;
+			core_tsk_prio(&rec->tsk, 0);
 			status =  OS_SUCCESS;
 		}
 	}
@@ -1185,7 +1186,7 @@ int32 OS_TaskGetInfo(uint32 task_id, OS_task_prop_t *task_prop)
 			task_prop->creator = rec->creator;
 			task_prop->stack_size = (uint32_t) rec->tsk.size;
 			task_prop->priority = ~rec->tsk.basic;
-			task_prop->OStask_id = (uint32) &rec->tsk;
+			task_prop->OStask_id = (uint32)(uintptr_t) &rec->tsk;
 			status = OS_SUCCESS;
 		}
 	}
@@ -1471,6 +1472,9 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name, uint32 *clock_acc
 
 					*timer_id = rec - OS_timer_table;
 					tmr_init(&rec->tmr, timer_handler);
+#if OS_TIMER_DAEMON
+					tmr_setDeferred(&rec->tmr, true);
+#endif
 					strcpy(rec->name, timer_name);
 					rec->creator = OS_TaskGetId();
 					rec->used = 1;
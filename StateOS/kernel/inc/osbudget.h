@@ -0,0 +1,375 @@
+/******************************************************************************
+
+    @file    StateOS: osbudget.h
+    @author  Rajmund Szymanski
+    @date    17.10.2018
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+
+#ifndef __STATEOS_BGT_H
+#define __STATEOS_BGT_H
+
+#include "oskernel.h"
+#include "ostimer.h"
+
+#if OS_BUDGET
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ *
+ * Name              : budget reservation
+ *
+ ******************************************************************************/
+
+struct __bgt
+{
+	tmr_t    tmr;    // replenishment timer
+
+	cnt_t    budget; // processor time granted to the attached tasks in every period (in ticks)
+	cnt_t    left;   // budget left in the current period
+	unsigned prio;   // background priority of the attached tasks after exhausting the budget
+	tsk_t  * list;   // list of the attached tasks
+};
+
+/******************************************************************************
+ *
+ * Name              : _BGT_INIT
+ *
+ * Description       : create and initialize a budget reservation object
+ *
+ * Parameters
+ *   budget          : processor time granted in every replenishment period (in ticks)
+ *   period          : replenishment period (in ticks)
+ *   prio            : background priority of the attached tasks after exhausting the budget
+ *
+ * Return            : budget reservation object
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#define               _BGT_INIT( _budget, _period, _prio ) { { _HDR_INIT(), core_bgt_handler, 0, 0, _period }, _budget, _budget, _prio, 0 }
+
+/******************************************************************************
+ *
+ * Name              : _VA_BGT
+ *
+ * Description       : calculate background priority from optional parameter
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#define               _VA_BGT( _prio ) ( _prio + 0 )
+
+/******************************************************************************
+ *
+ * Name              : OS_BGT
+ *
+ * Description       : define and initialize a budget reservation object
+ *
+ * Parameters
+ *   bgt             : name of a pointer to budget reservation object
+ *   budget          : processor time granted in every replenishment period (in ticks)
+ *   period          : replenishment period (in ticks)
+ *   prio            : (optional) background priority of the attached tasks; default: 0
+ *
+ ******************************************************************************/
+
+#define             OS_BGT( bgt, budget, period, ... )                                      \
+                       bgt_t bgt##__bgt = _BGT_INIT( budget, period, _VA_BGT(__VA_ARGS__) ); \
+                       bgt_id bgt = & bgt##__bgt
+
+/******************************************************************************
+ *
+ * Name              : static_BGT
+ *
+ * Description       : define and initialize a static budget reservation object
+ *
+ * Parameters
+ *   bgt             : name of a pointer to budget reservation object
+ *   budget          : processor time granted in every replenishment period (in ticks)
+ *   period          : replenishment period (in ticks)
+ *   prio            : (optional) background priority of the attached tasks; default: 0
+ *
+ ******************************************************************************/
+
+#define         static_BGT( bgt, budget, period, ... )                                      \
+                static bgt_t bgt##__bgt = _BGT_INIT( budget, period, _VA_BGT(__VA_ARGS__) ); \
+                static bgt_id bgt = & bgt##__bgt
+
+/******************************************************************************
+ *
+ * Name              : BGT_INIT
+ *
+ * Description       : create and initialize a budget reservation object
+ *
+ * Parameters
+ *   budget          : processor time granted in every replenishment period (in ticks)
+ *   period          : replenishment period (in ticks)
+ *   prio            : (optional) background priority of the attached tasks; default: 0
+ *
+ * Return            : budget reservation object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                BGT_INIT( budget, period, ... ) \
+                      _BGT_INIT( budget, period, _VA_BGT(__VA_ARGS__) )
+#endif
+
+/******************************************************************************
+ *
+ * Name              : BGT_CREATE
+ * Alias             : BGT_NEW
+ *
+ * Description       : create and initialize a budget reservation object
+ *
+ * Parameters
+ *   budget          : processor time granted in every replenishment period (in ticks)
+ *   period          : replenishment period (in ticks)
+ *   prio            : (optional) background priority of the attached tasks; default: 0
+ *
+ * Return            : pointer to budget reservation object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                BGT_CREATE( budget, period, ... ) \
+           (bgt_t[]) { BGT_INIT  ( budget, period, _VA_BGT(__VA_ARGS__) ) }
+#define                BGT_NEW \
+                       BGT_CREATE
+#endif
+
+/******************************************************************************
+ *
+ * Name              : bgt_init
+ *
+ * Description       : initialize a budget reservation object
+ *
+ * Parameters
+ *   bgt             : pointer to budget reservation object
+ *   budget          : processor time granted in every replenishment period (in ticks)
+ *   period          : replenishment period (in ticks)
+ *   prio            : background priority of the attached tasks after exhausting the budget
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void bgt_init( bgt_t *bgt, cnt_t budget, cnt_t period, unsigned prio );
+
+/******************************************************************************
+ *
+ * Name              : bgt_create
+ * Alias             : bgt_new
+ *
+ * Description       : create and initialize a new budget reservation object
+ *
+ * Parameters
+ *   budget          : processor time granted in every replenishment period (in ticks)
+ *   period          : replenishment period (in ticks)
+ *   prio            : background priority of the attached tasks after exhausting the budget
+ *
+ * Return            : pointer to budget reservation object (budget reservation successfully created)
+ *   0               : budget reservation not created (not enough free memory)
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+bgt_t *bgt_create( cnt_t budget, cnt_t period, unsigned prio );
+
+__STATIC_INLINE
+bgt_t *bgt_new( cnt_t budget, cnt_t period, unsigned prio ) { return bgt_create(budget, period, prio); }
+
+/******************************************************************************
+ *
+ * Name              : bgt_start
+ *
+ * Description       : refill the budget and start the periodic replenishment
+ *                     the processor time used by the attached tasks is charged with every tick of the system timer
+ *
+ * Parameters
+ *   bgt             : pointer to budget reservation object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void bgt_start( bgt_t *bgt );
+
+/******************************************************************************
+ *
+ * Name              : bgt_kill
+ * Alias             : bgt_stop
+ *
+ * Description       : stop the replenishment and restore the priorities of the attached tasks
+ *                     processor time of the attached tasks is not limited until the next bgt_start
+ *
+ * Parameters
+ *   bgt             : pointer to budget reservation object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void bgt_kill( bgt_t *bgt );
+
+__STATIC_INLINE
+void bgt_stop( bgt_t *bgt ) { bgt_kill(bgt); }
+
+/******************************************************************************
+ *
+ * Name              : bgt_delete
+ *
+ * Description       : stop the replenishment, detach all tasks and free allocated resource
+ *
+ * Parameters
+ *   bgt             : pointer to budget reservation object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void bgt_delete( bgt_t *bgt );
+
+/******************************************************************************
+ *
+ * Name              : bgt_attach
+ *
+ * Description       : attach the task to the budget reservation object (and detach it from the previous one)
+ *                     the task is immediately demoted if the budget has already been exhausted
+ *
+ * Parameters
+ *   bgt             : pointer to budget reservation object
+ *   tsk             : pointer to task object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     the task remains attached when it is stopped and restarted
+ *                     detach the task before it is reinitialized or deleted
+ *
+ ******************************************************************************/
+
+void bgt_attach( bgt_t *bgt, tsk_t *tsk );
+
+/******************************************************************************
+ *
+ * Name              : bgt_detach
+ *
+ * Description       : detach the task from its budget reservation object and restore the task priority
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+void bgt_detach( tsk_t *tsk );
+
+/******************************************************************************
+ *
+ * Name              : bgt_getLeft
+ * ISR alias         : bgt_getLeftISR
+ *
+ * Description       : get the budget left in the current replenishment period
+ *
+ * Parameters
+ *   bgt             : pointer to budget reservation object
+ *
+ * Return            : remaining processor time (in ticks); 0 when the attached tasks are demoted
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+cnt_t bgt_getLeft( bgt_t *bgt );
+
+__STATIC_INLINE
+cnt_t bgt_getLeftISR( bgt_t *bgt ) { return bgt_getLeft(bgt); }
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+
+/******************************************************************************
+ *
+ * Class             : Budget
+ *
+ * Description       : create and initialize a budget reservation object
+ *
+ * Constructor parameters
+ *   budget          : processor time granted in every replenishment period (in ticks)
+ *   period          : replenishment period (in ticks)
+ *   prio            : background priority of the attached tasks after exhausting the budget
+ *
+ ******************************************************************************/
+
+struct Budget : public __bgt
+{
+	 Budget( const cnt_t _budget, const cnt_t _period, const unsigned _prio = 0 ): __bgt _BGT_INIT(_budget, _period, _prio) {}
+	~Budget( void ) { assert(__bgt::list == nullptr); }
+
+	void     start     ( void )       {        bgt_start     (this);      }
+	void     kill      ( void )       {        bgt_kill      (this);      }
+	void     stop      ( void )       {        bgt_stop      (this);      }
+	void     attach    ( tsk_t *tsk ) {        bgt_attach    (this, tsk); }
+	cnt_t    getLeft   ( void )       { return bgt_getLeft   (this);      }
+	cnt_t    getLeftISR( void )       { return bgt_getLeftISR(this);      }
+};
+
+#endif//__cplusplus
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_BUDGET
+
+#endif//__STATEOS_BGT_H
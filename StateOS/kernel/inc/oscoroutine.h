@@ -0,0 +1,403 @@
+/******************************************************************************
+
+    @file    StateOS: oscoroutine.h
+    @author  Rajmund Szymanski
+    @date    17.10.2018
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOS_COR_H
+#define __STATEOS_COR_H
+
+#include "os.h"
+
+/* -------------------------------------------------------------------------- */
+
+#if defined(__cplusplus) && defined(__cpp_impl_coroutine)
+
+// stackless coroutines multiplexed on one task (C++20 coroutines, -std=c++20 or -fcoroutines)
+// coroutine frames are allocated from the system heap; a waiting coroutine does not occupy any task stack
+// a waiting coroutine is represented in the blocked queue of the awaited object by a proxy (see core_prx_wait);
+// the object releases the proxy like a waiting task, the proxy moves the coroutine to the ready queue of the executor
+// and resumes the executor task, which waits in the kernel while there are no ready coroutines
+
+#include <coroutine>
+
+struct CoroutineExecutor;
+
+/******************************************************************************
+ *
+ * Class             : CoroutineNode
+ *
+ * Description       : element of the executor queues, for internal use
+ *
+ ******************************************************************************/
+
+struct CoroutineNode
+{
+	CoroutineNode         * next_;   // next element in the executor queue
+	std::coroutine_handle<> handle_; // coroutine to be resumed
+};
+
+/******************************************************************************
+ *
+ * Class             : Coroutine
+ *
+ * Description       : return type of the coroutine function
+ *                     the coroutine is suspended until it is started by the executor (CoroutineExecutor::spawn)
+ *                     the coroutine frame is released automatically when the coroutine function returns
+ *
+ * Note              : the coroutine function may use co_await with the awaitables listed below (coWait, coSleepFor, ...)
+ *
+ ******************************************************************************/
+
+struct Coroutine
+{
+	struct promise_type : public CoroutineNode
+	{
+		CoroutineExecutor *exe_ = nullptr; // executor of the coroutine
+
+		static void *operator new   ( size_t _size ) noexcept { return sys_alloc(_size); }
+		static void  operator delete( void *_ptr )            {        sys_free(_ptr);   }
+
+		static
+		Coroutine get_return_object_on_allocation_failure( void ) { return Coroutine(nullptr); }
+		Coroutine get_return_object( void ) { return Coroutine(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+		std::suspend_always initial_suspend    ( void ) noexcept { return {}; }
+		std::suspend_never  final_suspend      ( void ) noexcept { return {}; }
+		void                return_void        ( void )          {}
+		void                unhandled_exception( void )          { assert(false); }
+
+		~promise_type( void );
+	};
+
+	explicit
+	 Coroutine( std::coroutine_handle<promise_type> _handle ): handle_(_handle) {}
+	 Coroutine( Coroutine &&_cor ): handle_(_cor.handle_) { _cor.handle_ = nullptr; }
+	~Coroutine( void ) { if (handle_) handle_.destroy(); } // the coroutine has never been started
+
+	Coroutine( const Coroutine & ) = delete;
+	Coroutine &operator=( const Coroutine & ) = delete;
+
+	bool operator!( void ) { return !handle_; }
+
+	private:
+	std::coroutine_handle<promise_type> handle_;
+	friend CoroutineExecutor;
+};
+
+/******************************************************************************
+ *
+ * Class             : CoroutineAwait
+ *
+ * Description       : base class of the awaitables, for internal use
+ *                     result of co_await: E_SUCCESS, E_TIMEOUT or E_FAILURE (as the blocking function of the object)
+ *
+ ******************************************************************************/
+
+struct CoroutineAwait : public CoroutineNode
+{
+	typedef unsigned take_t( CoroutineAwait * ); // non-blocking attempt; E_TIMEOUT: the coroutine has to wait
+	typedef tsk_t  **wait_t( CoroutineAwait * ); // prepare the proxy for waiting; return the blocked queue of the object
+
+	CoroutineAwait( take_t *_take, wait_t *_wait, const cnt_t _delay ): take_(_take), wait_(_wait), delay_(_delay) {}
+
+	CoroutineAwait( const CoroutineAwait & ) = delete;
+	CoroutineAwait &operator=( const CoroutineAwait & ) = delete;
+
+	bool     await_ready  ( void ) { event_ = take(); return event_ != E_TIMEOUT || delay_ == IMMEDIATE; }
+	void     await_suspend( std::coroutine_handle<Coroutine::promise_type> _handle );
+	unsigned await_resume ( void ) { return event_; }
+
+	unsigned take         ( void ) { return take_ ? take_(this) : E_TIMEOUT; }
+
+	// return the delay to the time point '_time'; IMMEDIATE if the time point has already passed (as core_tsk_waitUntil)
+	static
+	cnt_t    until_       ( const cnt_t _time ) { cnt_t delay = _time - sys_time(); return delay > ((CNT_MAX)>>1) ? IMMEDIATE : delay; }
+
+	static
+	void     resume_      ( tsk_t *_prx );
+
+	struct Proxy
+	{
+		tsk_t               tsk;   // task control block waiting in place of the coroutine
+		CoroutineAwait    * await;
+		CoroutineExecutor * exe;   // executor of the coroutine
+	};
+
+	take_t * take_;
+	wait_t * wait_;  // 0: the coroutine waits only for the timeout
+	cnt_t    delay_;
+	unsigned event_;
+	tsk_t  * queue_ = nullptr; // private blocked queue of the proxy waiting only for the timeout
+	Proxy    proxy_;
+};
+
+/******************************************************************************
+ *
+ * Class             : CoroutineExecutor
+ *
+ * Description       : create and initialize an executor of coroutines
+ *
+ * Note              : run() has to be called by the task hosting the coroutines
+ *                     spawn() may be called before run() or by the coroutines of the executor
+ *
+ ******************************************************************************/
+
+struct CoroutineExecutor
+{
+	 CoroutineExecutor( void ) {}
+	~CoroutineExecutor( void ) { assert(count_ == 0); }
+
+	CoroutineExecutor( const CoroutineExecutor & ) = delete;
+	CoroutineExecutor &operator=( const CoroutineExecutor & ) = delete;
+
+	bool spawn( Coroutine &&_cor )
+	{
+		if (!_cor)
+			return false;
+		Coroutine::promise_type &prm = _cor.handle_.promise();
+		prm.exe_    = this;
+		prm.handle_ = _cor.handle_;
+		_cor.handle_ = nullptr;
+		count_++;
+		sys_lock();
+		{
+			push_(&prm);
+		}
+		sys_unlock();
+		return true;
+	}
+
+	// execute the coroutines until all of them return
+	void run( void )
+	{
+		CoroutineNode *node;
+
+		while (count_ > 0)
+		{
+			sys_lock();
+			{
+				while ((node = pop_()) == nullptr) // all the coroutines are waiting
+					core_tsk_waitFor(&queue_, INFINITE);
+			}
+			sys_unlock();
+
+			node->handle_.resume();
+		}
+	}
+
+	unsigned count( void ) { return count_; }
+
+	// the ready queue is used by the proxies resumed in the interrupt handlers; call it with the kernel locked
+	void push_( CoroutineNode *_node )
+	{
+		_node->next_ = nullptr;
+		if (tail_) tail_->next_ = _node; else head_ = _node;
+		tail_ = _node;
+	}
+
+	CoroutineNode *pop_( void )
+	{
+		CoroutineNode *node = head_;
+		if (node && (head_ = node->next_) == nullptr)
+			tail_ = nullptr;
+		return node;
+	}
+
+	private:
+	unsigned       count_ = 0;       // number of coroutines
+	CoroutineNode *head_  = nullptr; // queue of ready coroutines
+	CoroutineNode *tail_  = nullptr;
+	tsk_t         *queue_ = nullptr; // executor task waiting for a ready coroutine
+
+	friend Coroutine::promise_type;
+	friend CoroutineAwait;
+};
+
+/* -------------------------------------------------------------------------- */
+
+inline
+Coroutine::promise_type::~promise_type( void ) { if (exe_) exe_->count_--; }
+
+// the take is repeated with the kernel locked, so the object cannot be released before the proxy is in its queue
+
+inline
+void CoroutineAwait::await_suspend( std::coroutine_handle<Coroutine::promise_type> _handle )
+{
+	CoroutineExecutor *exe = _handle.promise().exe_;
+
+	handle_ = _handle;
+
+	sys_lock();
+	{
+		event_ = take();
+
+		if (event_ != E_TIMEOUT)
+			exe->push_(this);
+		else
+		{
+			memset(&proxy_.tsk, 0, sizeof(tsk_t));
+			core_hdr_init(&proxy_.tsk.hdr);
+			proxy_.tsk.state = reinterpret_cast<fun_t *>(resume_);
+			proxy_.tsk.prio  = System.cur->prio;
+			proxy_.await     = this;
+			proxy_.exe       = exe;
+			core_prx_wait(&proxy_.tsk, wait_ ? wait_(this) : &queue_, delay_);
+		}
+	}
+	sys_unlock();
+}
+
+// the proxy has been resumed by the object or by the timeout; the kernel is locked
+
+inline
+void CoroutineAwait::resume_( tsk_t *_prx )
+{
+	CoroutineAwait    *await = reinterpret_cast<Proxy *>(_prx)->await;
+	CoroutineExecutor *exe   = reinterpret_cast<Proxy *>(_prx)->exe;
+
+	await->event_ = _prx->event;
+	exe->push_(await);
+	core_one_wakeup(exe->queue_, E_SUCCESS);
+}
+
+/******************************************************************************
+ *
+ * Name              : coYield
+ *
+ * Description       : pass control to the next ready coroutine of the executor
+ *
+ * Return            : E_SUCCESS
+ *
+ ******************************************************************************/
+
+struct coYield : public std::suspend_always
+{
+	void     await_suspend( std::coroutine_handle<Coroutine::promise_type> _handle ) { _handle.promise().handle_ = _handle; sys_lock(); _handle.promise().exe_->push_(&_handle.promise()); sys_unlock(); }
+	unsigned await_resume ( void ) { return E_SUCCESS; }
+};
+
+/******************************************************************************
+ *
+ * Name              : coSleepFor
+ * Name              : coSleepUntil
+ *
+ * Description       : delay execution of the current coroutine for given duration / until given time
+ *
+ * Parameters
+ *   delay           : duration of time (maximum number of ticks to delay execution of the coroutine)
+ *   time            : timepoint value
+ *
+ * Return            : E_TIMEOUT
+ *
+ * Note              : a time point that has already passed ends the delay at once
+ *
+ ******************************************************************************/
+
+struct coSleepFor : public CoroutineAwait
+{
+	coSleepFor( const cnt_t _delay ): CoroutineAwait(nullptr, nullptr, _delay) {}
+};
+
+struct coSleepUntil : public coSleepFor
+{
+	coSleepUntil( const cnt_t _time ): coSleepFor(until_(_time)) {}
+};
+
+/******************************************************************************
+ *
+ * Name              : coWaitFor
+ * Name              : coWaitUntil
+ * Name              : coWait
+ *
+ * Description       : wait for the object for given duration / until given time / indefinitely
+ *                     (semaphore, flag, mailbox queue, event queue, one-shot timer)
+ *
+ * Parameters
+ *   sem / flg / box / evq / tmr : pointer to the object (StateOS C++ objects may be passed by address)
+ *   flags           : all flags to wait for (flag object)
+ *   mode            : waiting mode, as in flg_wait (flag object)
+ *   data            : pointer to store the received mail / event (mailbox and event queue)
+ *   delay           : duration of time (maximum number of ticks to wait for the object)
+ *   time            : timepoint value
+ *
+ * Return            : as the corresponding blocking function of the object
+ *
+ ******************************************************************************/
+
+struct coWaitFor : public CoroutineAwait
+{
+	coWaitFor( sem_t *_sem,                              cnt_t _delay ): CoroutineAwait(semTake_, semWait_, _delay), obj_(_sem) {}
+	coWaitFor( flg_t *_flg, unsigned _flags, char _mode, cnt_t _delay ): CoroutineAwait(flgTake_, flgWait_, _delay), obj_(_flg), flags_(_flags), mode_(_mode) {}
+	coWaitFor( box_t *_box, void *_data,                 cnt_t _delay ): CoroutineAwait(boxTake_, boxWait_, _delay), obj_(_box), data_(_data) {}
+	coWaitFor( evq_t *_evq, unsigned *_data,             cnt_t _delay ): CoroutineAwait(evqTake_, evqWait_, _delay), obj_(_evq), data_(_data) {}
+	coWaitFor( tmr_t *_tmr,                              cnt_t _delay ): CoroutineAwait(tmrTake_, tmrWait_, _delay), obj_(_tmr) {}
+
+	private:
+	void   * obj_;
+	void   * data_  = nullptr;
+	unsigned flags_ = 0; // flags still awaited (flag object)
+	char     mode_  = 0;
+
+	static unsigned semTake_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); return sem_take((sem_t *)w->obj_); }
+	static unsigned flgTake_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); return (w->flags_ = flg_take((flg_t *)w->obj_, w->flags_, w->mode_)) ? E_TIMEOUT : E_SUCCESS; }
+	static unsigned boxTake_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); return box_take((box_t *)w->obj_, w->data_); }
+	static unsigned evqTake_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); return evq_take((evq_t *)w->obj_, (unsigned *)w->data_); }
+	static unsigned tmrTake_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); return tmr_take((tmr_t *)w->obj_); }
+
+	// the proxy gets the temporary data of the object, as the current task in the blocking function
+	static tsk_t  **semWait_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); return &((sem_t *)w->obj_)->obj.queue; }
+	static tsk_t  **flgWait_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); w->proxy_.tsk.tmp.flg.mode = w->mode_; w->proxy_.tsk.tmp.flg.flags = w->flags_; return &((flg_t *)w->obj_)->obj.queue; }
+	static tsk_t  **boxWait_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); w->proxy_.tsk.tmp.box.data.in = w->data_; return &((box_t *)w->obj_)->obj.queue; }
+	static tsk_t  **evqWait_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); w->proxy_.tsk.tmp.evq.data.in = (unsigned *)w->data_; return &((evq_t *)w->obj_)->obj.queue; }
+	static tsk_t  **tmrWait_( CoroutineAwait *_await ) { coWaitFor *w = static_cast<coWaitFor *>(_await); return &((tmr_t *)w->obj_)->hdr.obj.queue; }
+};
+
+struct coWaitUntil : public coWaitFor
+{
+	coWaitUntil( sem_t *_sem,                              cnt_t _time ): coWaitFor(_sem,                until_(_time)) {}
+	coWaitUntil( flg_t *_flg, unsigned _flags, char _mode, cnt_t _time ): coWaitFor(_flg, _flags, _mode, until_(_time)) {}
+	coWaitUntil( box_t *_box, void *_data,                 cnt_t _time ): coWaitFor(_box, _data,         until_(_time)) {}
+	coWaitUntil( evq_t *_evq, unsigned *_data,             cnt_t _time ): coWaitFor(_evq, _data,         until_(_time)) {}
+	coWaitUntil( tmr_t *_tmr,                              cnt_t _time ): coWaitFor(_tmr,                until_(_time)) {}
+};
+
+struct coWait : public coWaitFor
+{
+	coWait( sem_t *_sem )                              : coWaitFor(_sem,                INFINITE) {}
+	coWait( flg_t *_flg, unsigned _flags, char _mode ) : coWaitFor(_flg, _flags, _mode, INFINITE) {}
+	coWait( box_t *_box, void *_data )                 : coWaitFor(_box, _data,         INFINITE) {}
+	coWait( evq_t *_evq, unsigned *_data )             : coWaitFor(_evq, _data,         INFINITE) {}
+	coWait( tmr_t *_tmr )                              : coWaitFor(_tmr,                INFINITE) {}
+};
+
+#endif//__cplusplus && __cpp_impl_coroutine
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOS_COR_H
@@ -167,6 +167,100 @@ lck_t core_get_lock( void )
 #define                sys_unlockISR() \
                        sys_unlock()
 
+/******************************************************************************
+ *
+ * Name              : core_lck_saved
+ *
+ * Description       : return interrupts state saved at the entry to the enclosing critical section (sys_lock)
+ *
+ * Parameters        : none
+ *
+ * Return            : saved interrupts state
+ *
+ * Note              : for internal use; the kernel loops open the interrupt window with this state (OS_LOCK_SPAN)
+ *
+ ******************************************************************************/
+
+#define                core_lck_saved() \
+                       (__LOCK)
+
+/******************************************************************************
+ *
+ * Name              : sys_suspendSched
+ *
+ * Description       : lock the scheduler of the current processor / defer preemption of the current task
+ *                     interrupts remain enabled, the task switch requested in the meantime is deferred
+ *                     the lock is nestable
+ *
+ * Parameters        : none
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     blocking functions must not be used while the scheduler is locked
+ *                     other processors keep scheduling their tasks (OS_CPU_COUNT > 1)
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void sys_suspendSched( void )
+{
+	assert_tsk_context();
+
+	sys_lock();
+	{
+		core_sch_lock();
+	}
+	sys_unlock();
+}
+
+/******************************************************************************
+ *
+ * Name              : sys_resumeSched
+ *
+ * Description       : unlock the scheduler of the current processor
+ *                     the deferred task switch is forced when the lock is released completely
+ *
+ * Parameters        : none
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void sys_resumeSched( void )
+{
+	assert_tsk_context();
+
+	sys_lock();
+	{
+		core_sch_unlock();
+	}
+	sys_unlock();
+}
+
+/******************************************************************************
+ *
+ * Name              : sys_getSchedLock
+ *
+ * Description       : return the nesting counter of the scheduler lock of the current processor
+ *
+ * Parameters        : none
+ *
+ * Return            : 0 if the scheduler is not locked
+ *
+ * Note              : may be used both in thread and handler mode
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+unsigned sys_getSchedLock( void )
+{
+	return System.hold;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -195,6 +289,27 @@ struct CriticalSection
 	lck_t lck;
 };
 
+/******************************************************************************
+ *
+ * Class             : SchedulerLock
+ *
+ * Description       : create and initialize a scheduler lock guard object
+ *                     preemption of the current task is deferred for the lifetime of the object, interrupts remain enabled
+ *
+ * Constructor parameters
+ *                   : none
+ *
+ ******************************************************************************/
+
+struct SchedulerLock
+{
+	 SchedulerLock( void ) { sys_suspendSched(); }
+	~SchedulerLock( void ) { sys_resumeSched();  }
+
+	SchedulerLock( const SchedulerLock & ) = delete;
+	SchedulerLock &operator=( const SchedulerLock & ) = delete;
+};
+
 #endif//__cplusplus
 
 /* -------------------------------------------------------------------------- */
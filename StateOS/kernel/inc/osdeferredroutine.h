@@ -0,0 +1,247 @@
+/******************************************************************************
+
+    @file    StateOS: osdeferredroutine.h
+    @author  Rajmund Szymanski
+    @date    17.10.2018
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOS_DSR_H
+#define __STATEOS_DSR_H
+
+#include "oskernel.h"
+
+#if OS_DSR_LEVELS
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ *
+ * Name              : deferred service routine
+ *                     the interrupt handler posts the routine with its argument, the worker task of the routine level
+ *                     executes it in thread mode; repeated posts of the pending routine are coalesced
+ *
+ ******************************************************************************/
+
+typedef struct __dsr dsr_t, * const dsr_id;
+
+typedef void act_t( void *arg ); // deferred service routine procedure
+
+struct __dsr
+{
+	dsr_t  * next;  // next routine in the queue of the worker
+	act_t  * fun;   // deferred service routine procedure
+	void   * arg;   // argument of the last post
+	unsigned prio;  // level of the routine (0 .. OS_DSR_LEVELS-1)
+	volatile
+	unsigned pend;  // number of posts since the last execution of the routine
+};
+
+/******************************************************************************
+ *
+ * Name              : _DSR_INIT
+ *
+ * Description       : create and initialize a deferred service routine object
+ *
+ * Parameters
+ *   prio            : level of the routine (0 .. OS_DSR_LEVELS-1)
+ *   fun             : deferred service routine procedure
+ *
+ * Return            : deferred service routine object
+ *
+ * Note              : for internal use
+ *
+ ******************************************************************************/
+
+#define               _DSR_INIT( _prio, _fun ) { 0, _fun, 0, _prio, 0 }
+
+/******************************************************************************
+ *
+ * Name              : OS_DSR
+ *
+ * Description       : define and initialize a deferred service routine object
+ *
+ * Parameters
+ *   dsr             : name of a pointer to deferred service routine object
+ *   prio            : level of the routine (0 .. OS_DSR_LEVELS-1)
+ *   fun             : deferred service routine procedure
+ *
+ ******************************************************************************/
+
+#define             OS_DSR( dsr, prio, fun )                     \
+                       dsr_t dsr##__dsr = _DSR_INIT( prio, fun ); \
+                       dsr_id dsr = & dsr##__dsr
+
+/******************************************************************************
+ *
+ * Name              : static_DSR
+ *
+ * Description       : define and initialize a static deferred service routine object
+ *
+ * Parameters
+ *   dsr             : name of a pointer to deferred service routine object
+ *   prio            : level of the routine (0 .. OS_DSR_LEVELS-1)
+ *   fun             : deferred service routine procedure
+ *
+ ******************************************************************************/
+
+#define         static_DSR( dsr, prio, fun )                     \
+                static dsr_t dsr##__dsr = _DSR_INIT( prio, fun ); \
+                static dsr_id dsr = & dsr##__dsr
+
+/******************************************************************************
+ *
+ * Name              : DSR_INIT
+ *
+ * Description       : create and initialize a deferred service routine object
+ *
+ * Parameters
+ *   prio            : level of the routine (0 .. OS_DSR_LEVELS-1)
+ *   fun             : deferred service routine procedure
+ *
+ * Return            : deferred service routine object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                DSR_INIT( prio, fun ) \
+                      _DSR_INIT( prio, fun )
+#endif
+
+/******************************************************************************
+ *
+ * Name              : DSR_CREATE
+ * Alias             : DSR_NEW
+ *
+ * Description       : create and initialize a deferred service routine object
+ *
+ * Parameters
+ *   prio            : level of the routine (0 .. OS_DSR_LEVELS-1)
+ *   fun             : deferred service routine procedure
+ *
+ * Return            : pointer to deferred service routine object
+ *
+ * Note              : use only in 'C' code
+ *
+ ******************************************************************************/
+
+#ifndef __cplusplus
+#define                DSR_CREATE( prio, fun ) \
+           (dsr_t[]) { DSR_INIT  ( prio, fun ) }
+#define                DSR_NEW \
+                       DSR_CREATE
+#endif
+
+/******************************************************************************
+ *
+ * Name              : dsr_init
+ *
+ * Description       : initialize a deferred service routine object
+ *
+ * Parameters
+ *   dsr             : pointer to deferred service routine object
+ *   prio            : level of the routine (0 .. OS_DSR_LEVELS-1)
+ *   fun             : deferred service routine procedure
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     the routine must not be pending
+ *
+ ******************************************************************************/
+
+void dsr_init( dsr_t *dsr, unsigned prio, act_t *fun );
+
+/******************************************************************************
+ *
+ * Name              : dsr_give
+ * ISR alias         : dsr_giveISR
+ *
+ * Description       : post the deferred service routine to the worker task of its level
+ *                     the worker with the priority OS_DSR_PRIO + prio executes the routine in thread mode
+ *                     repeated posts of the pending routine are coalesced: the routine is executed once,
+ *                     with the argument of the last post
+ *
+ * Parameters
+ *   dsr             : pointer to deferred service routine object
+ *   arg             : argument of the routine
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     the routine is queued without disabling the interrupts (lock-free),
+ *                     the kernel is entered only to resume the idle worker by the first post of the batch
+ *
+ ******************************************************************************/
+
+void dsr_give( dsr_t *dsr, void *arg );
+
+__STATIC_INLINE
+void dsr_giveISR( dsr_t *dsr, void *arg ) { dsr_give(dsr, arg); }
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+
+/******************************************************************************
+ *
+ * Class             : DeferredRoutine
+ *
+ * Description       : create and initialize a deferred service routine object
+ *
+ * Constructor parameters
+ *   prio            : level of the routine (0 .. OS_DSR_LEVELS-1)
+ *   fun             : deferred service routine procedure
+ *
+ ******************************************************************************/
+
+struct DeferredRoutine : public __dsr
+{
+	 DeferredRoutine( const unsigned _prio, act_t *_fun ): __dsr _DSR_INIT(_prio, _fun) {}
+	~DeferredRoutine( void ) { assert(__dsr::pend == 0); }
+
+	DeferredRoutine( const DeferredRoutine & ) = delete;
+	DeferredRoutine &operator=( const DeferredRoutine & ) = delete;
+
+	void give   ( void *_arg = nullptr ) { dsr_give   (this, _arg); }
+	void giveISR( void *_arg = nullptr ) { dsr_giveISR(this, _arg); }
+};
+
+#endif//__cplusplus
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_DSR_LEVELS
+
+#endif//__STATEOS_DSR_H
@@ -64,6 +64,12 @@ struct __flg
 	obj_t    obj;   // object header
 
 	unsigned flags; // flag's current value
+#if OS_ISR_LOCKFREE
+	pnd_t    pnd;   // flags set by flg_giveISR
+	#define _FLG_PEND , _PND_INIT()
+#else
+	#define _FLG_PEND
+#endif
 };
 
 /******************************************************************************
@@ -81,7 +87,7 @@ struct __flg
  *
  ******************************************************************************/
 
-#define               _FLG_INIT( init ) { _OBJ_INIT(), init }
+#define               _FLG_INIT( init ) { _OBJ_INIT(), init _FLG_PEND }
 
 /******************************************************************************
  *
@@ -370,7 +376,7 @@ unsigned flg_wait( flg_t *flg, unsigned flags, char mode ) { return flg_waitFor(
  *
  * Name              : flg_give
  * Alias             : flg_set
- * ISR alias         : flg_giveISR
+ * ISR alias         : flg_giveISR (see below when OS_ISR_LOCKFREE > 0)
  *
  * Description       : set given flags in flag object
  *
@@ -389,8 +395,33 @@ unsigned flg_give( flg_t *flg, unsigned flags );
 __STATIC_INLINE
 unsigned flg_set( flg_t *flg, unsigned flags ) { return flg_give(flg, flags); }
 
+#if OS_ISR_LOCKFREE == 0
 __STATIC_INLINE
 unsigned flg_giveISR( flg_t *flg, unsigned flags ) { return flg_give(flg, flags); }
+#endif
+
+/******************************************************************************
+ *
+ * Name              : flg_giveISR
+ *
+ * Description       : record given flags in flag object without disabling the interrupts
+ *                     the flags are set by the kernel handler as with flg_give, just after the interrupt
+ *
+ * Parameters
+ *   flg             : pointer to flag object
+ *   flags           : all flags to set
+ *
+ * Return            : flags in flag object with the recorded flags (before the waiting tasks are served)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     also in the handlers with priority above OS_LOCK_LEVEL
+ *                     only this version is available when OS_ISR_LOCKFREE > 0
+ *
+ ******************************************************************************/
+
+#if OS_ISR_LOCKFREE
+unsigned flg_giveISR( flg_t *flg, unsigned flags );
+#endif
 
 /******************************************************************************
  *
@@ -51,7 +51,11 @@ extern "C" {
 #define mtxPrioNone      0 // none
 #define mtxPrioInherit   4 // priority inheritance mutex
 #define mtxPrioProtect   8 // priority protected mutex (OCPP)
+#define mtxPrioSRP      12 // stack resource policy mutex (immediate priority ceiling)
 #define mtxPrioMASK   ( mtxPrioNone | mtxPrioInherit | mtxPrioProtect )
+// the owner of mtxPrioSRP mutex runs with the mutex priority (ceiling) as soon as the mutex is locked;
+// tasks with priority not higher than the ceiling are not dispatched and never block on the mutex (on the same processor),
+// so basic tasks with the same priority can share one stack (OS_BASIC_STACK)
 
 /////// mutex robustness
 #define mtxStalled       0 // stalled mutex
@@ -80,8 +84,10 @@ struct __mtx
 	tsk_t  * owner; // mutex owner
 	unsigned mode;  // mutex mode: mutex type + mutex protocol + mutex robustness
 	unsigned count; // current value of the mutex counter
-	unsigned prio;  // mutex priority; unused if mtxPrioProtect protocol is not set
-	mtx_t  * list;  // list of mutexes held by owner
+	unsigned prio;  // mutex priority; unused if neither mtxPrioProtect nor mtxPrioSRP protocol is set
+	unsigned boost; // priority inherited by the owner from the mutex (cached)
+	mtx_t  * list;  // next mutex in the list of mutexes held by owner
+	mtx_t ** back;  // previous mutex in the list of mutexes held by owner
 };
 
 /******************************************************************************
@@ -93,9 +99,9 @@ struct __mtx
  * Parameters
  *   mode            : mutex mode (mutex type + mutex protocol + mutex robustness)
  *                           type: mtxNormal or mtxErrorCheck or mtxRecursive
- *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect
+ *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect or mtxPrioSRP
  *                     robustness: mtxStalled or mtxRobust
- *   prio            : mutex priority; unused if mtxPrioProtect protocol is not set
+ *   prio            : mutex priority; unused if neither mtxPrioProtect nor mtxPrioSRP protocol is set
  *
  * Return            : mutex object
  *
@@ -103,7 +109,7 @@ struct __mtx
  *
  ******************************************************************************/
 
-#define               _MTX_INIT( _mode, _prio ) { _OBJ_INIT(), 0, _mode, 0, _prio, 0 }
+#define               _MTX_INIT( _mode, _prio ) { _OBJ_INIT(), 0, _mode, 0, _prio, 0, 0, 0 }
 
 /******************************************************************************
  *
@@ -128,9 +134,9 @@ struct __mtx
  *   mtx             : name of a pointer to mutex object
  *   mode            : mutex mode (mutex type + mutex protocol + mutex robustness)
  *                           type: mtxNormal or mtxErrorCheck or mtxRecursive
- *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect
+ *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect or mtxPrioSRP
  *                     robustness: mtxStalled or mtxRobust
- *   prio            : mutex priority; unused if mtxPrioProtect protocol is not set
+ *   prio            : mutex priority; unused if neither mtxPrioProtect nor mtxPrioSRP protocol is set
  *
  ******************************************************************************/
 
@@ -148,9 +154,9 @@ struct __mtx
  *   mtx             : name of a pointer to mutex object
  *   mode            : mutex mode (mutex type + mutex protocol + mutex robustness)
  *                           type: mtxNormal or mtxErrorCheck or mtxRecursive
- *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect
+ *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect or mtxPrioSRP
  *                     robustness: mtxStalled or mtxRobust
- *   prio            : mutex priority; unused if mtxPrioProtect protocol is not set
+ *   prio            : mutex priority; unused if neither mtxPrioProtect nor mtxPrioSRP protocol is set
  *
  ******************************************************************************/
 
@@ -167,9 +173,9 @@ struct __mtx
  * Parameters
  *   mode            : mutex mode (mutex type + mutex protocol + mutex robustness)
  *                           type: mtxNormal or mtxErrorCheck or mtxRecursive
- *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect
+ *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect or mtxPrioSRP
  *                     robustness: mtxStalled or mtxRobust
- *   prio            : mutex priority; unused if mtxPrioProtect protocol is not set
+ *   prio            : mutex priority; unused if neither mtxPrioProtect nor mtxPrioSRP protocol is set
  *
  * Return            : mutex object
  *
@@ -192,9 +198,9 @@ struct __mtx
  * Parameters
  *   mode            : mutex mode (mutex type + mutex protocol + mutex robustness)
  *                           type: mtxNormal or mtxErrorCheck or mtxRecursive
- *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect
+ *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect or mtxPrioSRP
  *                     robustness: mtxStalled or mtxRobust
- *   prio            : mutex priority; unused if mtxPrioProtect protocol is not set
+ *   prio            : mutex priority; unused if neither mtxPrioProtect nor mtxPrioSRP protocol is set
  *
  * Return            : pointer to mutex object
  *
@@ -219,9 +225,9 @@ struct __mtx
  *   mtx             : pointer to mutex object
  *   mode            : mutex mode (mutex type + mutex protocol + mutex robustness)
  *                           type: mtxNormal or mtxErrorCheck or mtxRecursive
- *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect
+ *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect or mtxPrioSRP
  *                     robustness: mtxStalled or mtxRobust
- *   prio            : mutex priority; unused if mtxPrioProtect protocol is not set
+ *   prio            : mutex priority; unused if neither mtxPrioProtect nor mtxPrioSRP protocol is set
  *
  * Return            : none
  *
@@ -241,9 +247,9 @@ void mtx_init( mtx_t *mtx, unsigned mode, unsigned prio );
  * Parameters
  *   mode            : mutex mode (mutex type + mutex protocol + mutex robustness)
  *                           type: mtxNormal or mtxErrorCheck or mtxRecursive
- *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect
+ *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect or mtxPrioSRP
  *                     robustness: mtxStalled or mtxRobust
- *   prio            : mutex priority; unused if mtxPrioProtect protocol is not set
+ *   prio            : mutex priority; unused if neither mtxPrioProtect nor mtxPrioSRP protocol is set
  *
  * Return            : pointer to mutex object (mutex successfully created)
  *   0               : mutex not created (not enough free memory)
@@ -478,9 +484,9 @@ unsigned mtx_unlock( mtx_t *mtx ) { return mtx_give(mtx); }
  * Constructor parameters
  *   mode            : mutex mode (mutex type + mutex protocol + mutex robustness)
  *                           type: mtxNormal or mtxErrorCheck or mtxRecursive
- *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect
+ *                       protocol: mtxPrioNone or mtxPrioInherit or mtxPrioProtect or mtxPrioSRP
  *                     robustness: mtxStalled or mtxRobust
- *   prio            : mutex priority; unused if mtxPrioProtect protocol is not set
+ *   prio            : mutex priority; unused if neither mtxPrioProtect nor mtxPrioSRP protocol is set
  *
  ******************************************************************************/
 
@@ -60,6 +60,12 @@ struct __sem
 
 	unsigned count; // current value of the semaphore counter
 	unsigned limit; // limit value of the semaphore counter
+#if OS_ISR_LOCKFREE
+	pnd_t    pnd;   // unlocks recorded by sem_giveISR
+	#define _SEM_PEND , _PND_INIT()
+#else
+	#define _SEM_PEND
+#endif
 };
 
 /******************************************************************************
@@ -81,7 +87,7 @@ struct __sem
  *
  ******************************************************************************/
 
-#define               _SEM_INIT( _init, _limit ) { _OBJ_INIT(), _init, _limit }
+#define               _SEM_INIT( _init, _limit ) { _OBJ_INIT(), _init, _limit _SEM_PEND }
 
 /******************************************************************************
  *
@@ -371,7 +377,7 @@ unsigned sem_wait( sem_t *sem ) { return sem_waitFor(sem, INFINITE); }
  *
  * Name              : sem_give
  * Alias             : sem_post
- * ISR alias         : sem_giveISR
+ * ISR alias         : sem_giveISR (see below when OS_ISR_LOCKFREE > 0)
  *
  * Description       : try to unlock the semaphore object,
  *                     don't wait if the semaphore object can't be unlocked immediately
@@ -393,8 +399,33 @@ unsigned sem_give( sem_t *sem );
 __STATIC_INLINE
 unsigned sem_post( sem_t *sem ) { return sem_give(sem); }
 
+#if OS_ISR_LOCKFREE == 0
 __STATIC_INLINE
 unsigned sem_giveISR( sem_t *sem ) { return sem_give(sem); }
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sem_giveISR
+ *
+ * Description       : record the unlock of the semaphore object without disabling the interrupts
+ *                     the unlock is resolved by the kernel handler as with sem_give, just after the interrupt
+ *
+ * Parameters
+ *   sem             : pointer to semaphore object
+ *
+ * Return
+ *   E_SUCCESS       : the unlock was recorded; it is lost if the semaphore counter has reached its limit
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     also in the handlers with priority above OS_LOCK_LEVEL
+ *                     only this version is available when OS_ISR_LOCKFREE > 0
+ *
+ ******************************************************************************/
+
+#if OS_ISR_LOCKFREE
+unsigned sem_giveISR( sem_t *sem );
+#endif
 
 /******************************************************************************
  *
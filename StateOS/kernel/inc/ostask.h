@@ -56,6 +56,22 @@ extern "C" {
 #define JOINABLE     ((tsk_t *)((uintptr_t)0))     // task in joinable state
 #define DETACHED     ((tsk_t *)((uintptr_t)0 - 1)) // task in detached state
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_TSK_NOTIFY
+
+#define ntfSetBits      0 // bitwise OR the notification value into the slot
+#define ntfIncrement    1 // increment the slot (the notification value is ignored)
+#define ntfOverwrite    2 // overwrite the slot with the notification value
+
+#define ntfAny          0 // wait for any of the given bits
+#define ntfAll          1 // wait for all of the given bits
+#define ntfProtect      2 // don't consume the received notification
+#define ntfCount        4 // wait for nonzero value of the slot and decrement it (the given bits are ignored)
+#define ntfMASK         7
+
+#endif
+
 /******************************************************************************
  *
  * Name              : task (thread)
@@ -70,6 +86,12 @@ struct __tsk
 	cnt_t    start; // inherited from timer
 	cnt_t    delay; // inherited from timer
 	cnt_t    slice;	// time slice
+#if OS_ROBIN
+	cnt_t    quantum; // length of the time slice (in ticks); 0: default value (OS_FREQUENCY)/(OS_ROBIN)
+	#define _TSK_QUANTUM 0,
+#else
+	#define _TSK_QUANTUM
+#endif
 
 	tsk_t ** back;  // previous object in the BLOCKED queue
 	stk_t  * stack; // base of stack
@@ -83,12 +105,71 @@ struct __tsk
 	tsk_t ** guard; // BLOCKED queue for the pending process
 
 	unsigned event; // wakeup event
+	tsk_t  * wai;   // private BLOCKED queue of the task waiting for its own flags (tsk_wait); it holds only the task itself
 
 	struct {
-	mtx_t  * list;  // list of mutexes held
+	mtx_t  * list;  // list of mutexes held, ordered by the priority inherited from them
 	mtx_t  * tree;  // tree of tasks waiting for mutexes
+	unsigned prio;  // highest priority inherited from the mutexes held (cached)
+	unsigned srp;   // number of stack resource policy mutexes held
 	}        mtx;
 
+#if OS_EDF_PRIO
+	cnt_t    deadline; // absolute deadline of the task (EDF scheduling)
+	#define _TSK_DEADLINE 0,
+#else
+	#define _TSK_DEADLINE
+#endif
+#if OS_BUDGET
+	struct {
+	bgt_t  * owner; // budget reservation of the task
+	tsk_t  * next;  // next task attached to the budget reservation
+	}        bgt;
+	#define _TSK_BUDGET { 0, 0 },
+#else
+	#define _TSK_BUDGET
+#endif
+#if OS_BASIC_STACK
+	struct {
+	struct __bsk *stk; // shared stack of the basic task; 0: task with private stack
+	bool     done;  // basic task is between invocations of its state function, its frame can be dropped
+	}        bsc;
+	#define _TSK_BASIC { 0, false },
+#else
+	#define _TSK_BASIC
+#endif
+#if OS_TASK_RUNTIME
+	uint64_t runtime; // processor time used by the task (in units of the runtime counter)
+	#define _TSK_RUNTIME 0,
+#else
+	#define _TSK_RUNTIME
+#endif
+#if OS_ISR_LOCKFREE
+	pnd_t    pnd;   // flags given by tsk_giveISR
+	#define _TSK_PEND _PND_INIT(),
+#else
+	#define _TSK_PEND
+#endif
+#if OS_TSK_NOTIFY
+	struct {
+	tsk_t  * wai;   // private BLOCKED queue of the task waiting for a notification; it holds only the task itself
+	uint32_t val[OS_TSK_NOTIFY]; // notification values
+#if OS_ISR_LOCKFREE
+	pnd_t    pnd;   // slots with the notifications of tsk_notifyISR pending (bit mask)
+	volatile
+	unsigned set[OS_TSK_NOTIFY]; // bits recorded by tsk_notifyISR (ntfSetBits)
+	volatile
+	unsigned inc[OS_TSK_NOTIFY]; // increments recorded by tsk_notifyISR (ntfIncrement)
+	#define _TSK_NTF_PEND , _PND_INIT(), { 0 }, { 0 }
+#else
+	#define _TSK_NTF_PEND
+#endif
+	}        ntf;
+	#define _TSK_NOTIFY { 0, { 0 } _TSK_NTF_PEND },
+#else
+	#define _TSK_NOTIFY
+#endif
+
 	union  {
 
 	struct {
@@ -100,6 +181,13 @@ struct __tsk
 	unsigned mode;
 	}        flg;   // temporary data used by flag object
 
+	struct {
+	uint32_t bits;
+	uint32_t value;
+	unsigned slot;
+	unsigned mode;
+	}        ntf;   // temporary data used by task notification
+
 	struct {
 	union  {
 	const
@@ -152,6 +240,9 @@ struct __tsk
 #if defined(__ARMCC_VERSION) && !defined(__MICROLIB)
 	char     libspace[96];
 	#define _TSK_EXTRA { 0 }
+#elif OS_CPU_COUNT > 1
+	unsigned cpu;   // processor the task is bound to
+	#define _TSK_EXTRA 0
 #else
 	#define _TSK_EXTRA
 #endif
@@ -177,7 +268,7 @@ struct __tsk
  ******************************************************************************/
 
 #define               _TSK_INIT( _prio, _state, _stack, _size ) \
-                       { _HDR_INIT(), _state, 0, 0, 0, 0, _stack, _size, 0, _prio, _prio, 0, 0, 0, { 0, 0 }, { { 0 } }, _TSK_EXTRA }
+                       { _HDR_INIT(), _state, 0, 0, 0, _TSK_QUANTUM 0, _stack, _size, 0, _prio, _prio, 0, 0, 0, 0, { 0, 0, 0, 0 }, _TSK_DEADLINE _TSK_BUDGET _TSK_BASIC _TSK_RUNTIME _TSK_PEND _TSK_NOTIFY { { 0 } }, _TSK_EXTRA }
 
 /******************************************************************************
  *
@@ -562,6 +653,101 @@ struct __tsk
                        TSK_CREATE
 #endif
 
+/******************************************************************************
+ *
+ * Name              : OS_BSC
+ *
+ * Description       : define and initialize basic task object
+ *                     basic task does not have a private stack; its state function runs to completion
+ *                     on the stack shared by all basic tasks with the same priority (OS_BASIC_STACK bytes)
+ *
+ * Parameters
+ *   tsk             : name of a pointer to task object
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *
+ * Note              : only available when OS_BASIC_STACK > 0
+ *
+ ******************************************************************************/
+
+#if OS_BASIC_STACK
+#define             OS_BSC( tsk, prio, state )                         \
+                       tsk_t tsk##__tsk = _TSK_INIT( prio, state, 0, 0 ); \
+                       tsk_id tsk = & tsk##__tsk
+#endif
+
+/******************************************************************************
+ *
+ * Name              : static_BSC
+ *
+ * Description       : define and initialize static basic task object
+ *
+ * Parameters
+ *   tsk             : name of a pointer to task object
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *
+ * Note              : only available when OS_BASIC_STACK > 0
+ *
+ ******************************************************************************/
+
+#if OS_BASIC_STACK
+#define         static_BSC( tsk, prio, state )                         \
+                static tsk_t tsk##__tsk = _TSK_INIT( prio, state, 0, 0 ); \
+                static tsk_id tsk = & tsk##__tsk
+#endif
+
+/******************************************************************************
+ *
+ * Name              : BSC_INIT
+ *
+ * Description       : create and initialize basic task object
+ *
+ * Parameters
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *
+ * Return            : task object
+ *
+ * Note              : use only in 'C' code
+ *                     only available when OS_BASIC_STACK > 0
+ *
+ ******************************************************************************/
+
+#if OS_BASIC_STACK && !defined(__cplusplus)
+#define                BSC_INIT( prio, state ) \
+                      _TSK_INIT( prio, state, 0, 0 )
+#endif
+
+/******************************************************************************
+ *
+ * Name              : BSC_CREATE
+ * Alias             : BSC_NEW
+ *
+ * Description       : create and initialize basic task object
+ *
+ * Parameters
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *
+ * Return            : pointer to task object
+ *
+ * Note              : use only in 'C' code
+ *                     only available when OS_BASIC_STACK > 0
+ *
+ ******************************************************************************/
+
+#if OS_BASIC_STACK && !defined(__cplusplus)
+#define                BSC_CREATE( prio, state ) \
+           (tsk_t[]) { BSC_INIT  ( prio, state ) }
+#define                BSC_NEW \
+                       BSC_CREATE
+#endif
+
 /******************************************************************************
  *
  * Name              : tsk_this
@@ -697,6 +883,65 @@ tsk_t *tsk_new   ( unsigned prio, fun_t *state ) { return wrk_create(prio, state
 __STATIC_INLINE
 tsk_t *tsk_detached( unsigned prio, fun_t *state ) { return wrk_detached(prio, state, OS_STACK_SIZE); }
 
+/******************************************************************************
+ *
+ * Name              : bsc_init
+ *
+ * Description       : initialize basic task object and start the task
+ *                     basic task does not have a private stack; its state function runs to completion
+ *                     on the stack shared by all basic tasks with the same priority (OS_BASIC_STACK bytes)
+ *                     blocking functions called by the basic task do not return: the wait ends the current
+ *                     invocation of the state function, the next one starts after the wakeup
+ *                     (the wakeup event is available in the 'event' field of the task object)
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_BASIC_STACK > 0
+ *                     basic task in the middle of its state function is not preempted by the tasks with the same priority
+ *                     priority of the basic task must not be changed while it is in the middle of its state function
+ *
+ ******************************************************************************/
+
+#if OS_BASIC_STACK
+__STATIC_INLINE
+void bsc_init( tsk_t *tsk, unsigned prio, fun_t *state ) { tsk_init(tsk, prio, state, 0, 0); }
+#endif
+
+/******************************************************************************
+ *
+ * Name              : bsc_create
+ * Alias             : bsc_new
+ *
+ * Description       : create and initialize basic task object and start the task
+ *
+ * Parameters
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *
+ * Return            : pointer to task object (task successfully created)
+ *   0               : task not created (not enough free memory)
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_BASIC_STACK > 0
+ *
+ ******************************************************************************/
+
+#if OS_BASIC_STACK
+__STATIC_INLINE
+tsk_t *bsc_create( unsigned prio, fun_t *state ) { return wrk_create(prio, state, 0); }
+
+__STATIC_INLINE
+tsk_t *bsc_new   ( unsigned prio, fun_t *state ) { return wrk_create(prio, state, 0); }
+#endif
+
 /******************************************************************************
  *
  * Name              : tsk_start
@@ -961,6 +1206,182 @@ void tsk_prio( unsigned prio ) { tsk_setPrio(prio); }
 
 unsigned tsk_getPrio( void );
 
+/******************************************************************************
+ *
+ * Name              : tsk_setDeadline
+ *
+ * Description       : set absolute deadline of current task
+ *                     ready tasks with priority OS_EDF_PRIO are ordered by their deadlines (the earliest first)
+ *
+ * Parameters
+ *   time            : absolute time of the deadline
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_EDF_PRIO > 0
+ *
+ ******************************************************************************/
+
+#if OS_EDF_PRIO
+void tsk_setDeadline( cnt_t time );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_getDeadline
+ *
+ * Description       : get absolute deadline of current task
+ *
+ * Parameters        : none
+ *
+ * Return            : absolute time of the deadline
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_EDF_PRIO > 0
+ *
+ ******************************************************************************/
+
+#if OS_EDF_PRIO
+cnt_t tsk_getDeadline( void );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_setCPU
+ *
+ * Description       : bind the inactive task to the processor, the task will be started on it
+ *                     new task is bound to the processor of the task that creates it
+ *
+ * Parameters
+ *   tsk             : pointer to inactive task object
+ *   cpu             : index of the processor (0 .. OS_CPU_COUNT-1)
+ *
+ * Return
+ *   E_SUCCESS       : task has been bound to the processor
+ *   E_FAILURE       : task is active or the processor does not exist
+ *
+ * Note              : use only in thread mode
+ *
+ ******************************************************************************/
+
+unsigned tsk_setCPU( tsk_t *tsk, unsigned cpu );
+
+/******************************************************************************
+ *
+ * Name              : tsk_setQuantum
+ *
+ * Description       : set the length of the round-robin time slice of the task
+ *                     CPU-bound tasks may use longer slices to reduce the number of context switches,
+ *                     interactive tasks may use shorter ones to share the processor with their peers more evenly
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   quantum         : length of the time slice (in ticks)
+ *                     0: default value (OS_FREQUENCY)/(OS_ROBIN)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_ROBIN > 0
+ *                     the new length is used from the next time slice of the task
+ *                     in tick-less mode the port has to support reprogramming of the time slice (port_ctx_slice),
+ *                     otherwise all tasks use the default value
+ *
+ ******************************************************************************/
+
+#if OS_ROBIN
+void tsk_setQuantum( tsk_t *tsk, cnt_t quantum );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_getQuantum
+ *
+ * Description       : get the length of the round-robin time slice of the task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *
+ * Return            : length of the time slice (in ticks); 0: default value (OS_FREQUENCY)/(OS_ROBIN)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only available when OS_ROBIN > 0
+ *
+ ******************************************************************************/
+
+#if OS_ROBIN
+__STATIC_INLINE
+cnt_t tsk_getQuantum( tsk_t *tsk ) { return tsk->quantum; }
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_setSlack
+ *
+ * Description       : set the slack of the task: tolerated delay of the end of its delays and timeouts
+ *                     (tsk_sleepFor, tsk_delay, xxx_waitFor, ...); the timeouts with overlapping windows
+ *                     are served together in one pass of the timer handler
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   slack           : tolerated delay (in ticks); 0: the delays and timeouts of the task end exactly on time (default)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_TIMER_SLACK > 0
+ *                     tsk_sleepNext keeps the period of the task, the slack does not accumulate
+ *                     the new value is used from the next delay or timeout of the task
+ *
+ ******************************************************************************/
+
+#if OS_TIMER_SLACK
+void tsk_setSlack( tsk_t *tsk, cnt_t slack );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_getSlack
+ *
+ * Description       : get the slack of the task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *
+ * Return            : tolerated delay of the end of delays and timeouts of the task (in ticks)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only available when OS_TIMER_SLACK > 0
+ *
+ ******************************************************************************/
+
+#if OS_TIMER_SLACK
+__STATIC_INLINE
+cnt_t tsk_getSlack( tsk_t *tsk ) { return tsk->hdr.slack; }
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_getRuntime
+ *
+ * Description       : get processor time used by the task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *
+ * Return            : processor time used by the task in units of the runtime counter
+ *                     (processor cycles if the port provides the cycle counter, system timer ticks otherwise)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only available when OS_TASK_RUNTIME > 0
+ *
+ ******************************************************************************/
+
+#if OS_TASK_RUNTIME
+uint64_t tsk_getRuntime( tsk_t *tsk );
+#endif
+
 /******************************************************************************
  *
  * Name              : tsk_waitFor
@@ -1028,7 +1449,7 @@ unsigned tsk_wait( unsigned flags ) { return tsk_waitFor(flags, INFINITE); }
 /******************************************************************************
  *
  * Name              : tsk_give
- * ISR alias         : tsk_giveISR
+ * ISR alias         : tsk_giveISR (see below when OS_ISR_LOCKFREE > 0)
  *
  * Description       : set given flags or event of waiting task (tsk_wait)
  *
@@ -1046,8 +1467,227 @@ unsigned tsk_wait( unsigned flags ) { return tsk_waitFor(flags, INFINITE); }
 
 unsigned tsk_give( tsk_t *tsk, unsigned flags );
 
+#if OS_ISR_LOCKFREE == 0
 __STATIC_INLINE
 unsigned tsk_giveISR( tsk_t *tsk, unsigned flags ) { return tsk_give(tsk, flags); }
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_giveISR
+ *
+ * Description       : record given flags for the waiting task (tsk_wait) without disabling the interrupts
+ *                     the flags are transferred by the kernel handler as with tsk_give, just after the interrupt
+ *
+ * Parameters
+ *   tsk             : pointer to blocked task object
+ *   flags           : flags to be transferred to the task
+ *
+ * Return
+ *   E_SUCCESS       : given flags were recorded; they are lost if the task does not wait when they are transferred
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     also in the handlers with priority above OS_LOCK_LEVEL
+ *                     flags recorded by consecutive calls are merged into one transfer
+ *                     only this version is available when OS_ISR_LOCKFREE > 0
+ *
+ ******************************************************************************/
+
+#if OS_ISR_LOCKFREE
+unsigned tsk_giveISR( tsk_t *tsk, unsigned flags );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_notifyWaitFor
+ *
+ * Description       : delay execution of current task for given duration of time and wait for a notification
+ *                     in given slot of the task; the task waits in its private queue (no queue is shared)
+ *
+ * Parameters
+ *   slot            : notification slot (0 .. OS_TSK_NOTIFY-1)
+ *   bits            : bits of the slot to wait for (ignored with ntfCount)
+ *   mode            : waiting mode
+ *                     ntfAny:     wait for any of the given bits, the received bits are cleared
+ *                     ntfAll:     wait for all of the given bits, the received bits are cleared
+ *                     ntfCount:   wait for nonzero value of the slot, the value is decremented
+ *                     ntfProtect: don't clear / decrement the slot (may be combined with the above)
+ *   value           : pointer to store the value of the slot before it was consumed; may be 0
+ *   delay           : duration of time (maximum number of ticks to delay execution of current task)
+ *                     IMMEDIATE: don't delay execution of current task
+ *                     INFINITE:  delay indefinitely execution of current task
+ *
+ * Return
+ *   E_SUCCESS       : notification has been received
+ *   E_TIMEOUT       : notification has not been received before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_TSK_NOTIFY > 0
+ *
+ ******************************************************************************/
+
+#if OS_TSK_NOTIFY
+unsigned tsk_notifyWaitFor( unsigned slot, uint32_t bits, char mode, uint32_t *value, cnt_t delay );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_notifyWaitUntil
+ *
+ * Description       : delay execution of current task until given timepoint and wait for a notification
+ *                     in given slot of the task; the task waits in its private queue (no queue is shared)
+ *
+ * Parameters
+ *   slot            : notification slot (0 .. OS_TSK_NOTIFY-1)
+ *   bits            : bits of the slot to wait for (ignored with ntfCount)
+ *   mode            : waiting mode (see tsk_notifyWaitFor)
+ *   value           : pointer to store the value of the slot before it was consumed; may be 0
+ *   time            : timepoint value
+ *
+ * Return
+ *   E_SUCCESS       : notification has been received
+ *   E_TIMEOUT       : notification has not been received before the specified timeout expired
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_TSK_NOTIFY > 0
+ *
+ ******************************************************************************/
+
+#if OS_TSK_NOTIFY
+unsigned tsk_notifyWaitUntil( unsigned slot, uint32_t bits, char mode, uint32_t *value, cnt_t time );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_notifyWait
+ *
+ * Description       : delay indefinitely execution of current task and wait for a notification in given slot of the task
+ *
+ * Parameters
+ *   slot            : notification slot (0 .. OS_TSK_NOTIFY-1)
+ *   bits            : bits of the slot to wait for (ignored with ntfCount)
+ *   mode            : waiting mode (see tsk_notifyWaitFor)
+ *   value           : pointer to store the value of the slot before it was consumed; may be 0
+ *
+ * Return
+ *   E_SUCCESS       : notification has been received
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_TSK_NOTIFY > 0
+ *
+ ******************************************************************************/
+
+#if OS_TSK_NOTIFY
+__STATIC_INLINE
+unsigned tsk_notifyWait( unsigned slot, uint32_t bits, char mode, uint32_t *value ) { return tsk_notifyWaitFor(slot, bits, mode, value, INFINITE); }
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_notify
+ * ISR alias         : tsk_notifyISR (see below when OS_ISR_LOCKFREE > 0)
+ *
+ * Description       : update given notification slot of the task and release the task if it waits for the notification
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   slot            : notification slot (0 .. OS_TSK_NOTIFY-1)
+ *   value           : notification value
+ *   action          : update of the slot
+ *                     ntfSetBits:   bitwise OR the value into the slot
+ *                     ntfIncrement: increment the slot, the value is ignored
+ *                     ntfOverwrite: overwrite the slot with the value
+ *
+ * Return            : value of the slot after the update (and after it was consumed by the released task)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     the notification is stored in the slot also when the task does not wait for it
+ *                     only available when OS_TSK_NOTIFY > 0
+ *
+ ******************************************************************************/
+
+#if OS_TSK_NOTIFY
+uint32_t tsk_notify( tsk_t *tsk, unsigned slot, uint32_t value, unsigned action );
+
+#if OS_ISR_LOCKFREE == 0
+__STATIC_INLINE
+uint32_t tsk_notifyISR( tsk_t *tsk, unsigned slot, uint32_t value, unsigned action ) { return tsk_notify(tsk, slot, value, action); }
+#endif
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_notifyISR
+ *
+ * Description       : record the notification for given slot of the task without disabling the interrupts
+ *                     the slot is updated and the waiting task is released by the kernel handler as with tsk_notify,
+ *                     just after the interrupt
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   slot            : notification slot (0 .. OS_TSK_NOTIFY-1)
+ *   value           : notification value
+ *   action          : update of the slot
+ *                     ntfSetBits:   bitwise OR the value into the slot
+ *                     ntfIncrement: increment the slot, the value is ignored
+ *                     ntfOverwrite: overwrite the slot with the value (with the interrupts disabled, as tsk_notify)
+ *
+ * Return            : value of the slot before the recorded notification is resolved (ntfSetBits, ntfIncrement)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     also in the handlers with priority above OS_LOCK_LEVEL, except ntfOverwrite
+ *                     bits and increments recorded for the slot by consecutive calls are resolved together, bits first
+ *                     only this version is available when OS_TSK_NOTIFY > 0 and OS_ISR_LOCKFREE > 0
+ *
+ ******************************************************************************/
+
+#if OS_TSK_NOTIFY && OS_ISR_LOCKFREE
+uint32_t tsk_notifyISR( tsk_t *tsk, unsigned slot, uint32_t value, unsigned action );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_notifyClear
+ *
+ * Description       : clear given bits of the notification slot of the task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   slot            : notification slot (0 .. OS_TSK_NOTIFY-1)
+ *   bits            : bits to be cleared
+ *
+ * Return            : value of the slot before clearing
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only available when OS_TSK_NOTIFY > 0
+ *
+ ******************************************************************************/
+
+#if OS_TSK_NOTIFY
+uint32_t tsk_notifyClear( tsk_t *tsk, unsigned slot, uint32_t bits );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tsk_notifyGet
+ *
+ * Description       : get value of the notification slot of the task
+ *
+ * Parameters
+ *   tsk             : pointer to task object
+ *   slot            : notification slot (0 .. OS_TSK_NOTIFY-1)
+ *
+ * Return            : value of the slot
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only available when OS_TSK_NOTIFY > 0
+ *
+ ******************************************************************************/
+
+#if OS_TSK_NOTIFY
+__STATIC_INLINE
+uint32_t tsk_notifyGet( tsk_t *tsk, unsigned slot ) { return tsk_notifyClear(tsk, slot, 0); }
+#endif
 
 /******************************************************************************
  *
@@ -1078,6 +1718,7 @@ void tsk_delay( cnt_t delay ) { tsk_sleepFor(delay); }
  *
  * Description       : delay execution of current task for given duration of time
  *                     from the end of the previous countdown
+ *                     when OS_EDF_PRIO > 0, the deadline of current task is set to the end of the next countdown
  *
  * Parameters
  *   delay           : duration of time (maximum number of ticks to delay execution of current task)
@@ -1225,8 +1866,26 @@ struct staticTaskT : public __tsk
 	void     reset    ( void )            {        tsk_reset     (this);         }
 	unsigned prio     ( void )            { return __tsk::basic;                 }
 	unsigned getPrio  ( void )            { return __tsk::basic;                 }
+	unsigned setCPU   ( unsigned _cpu )   { return tsk_setCPU    (this, _cpu);   }
+#if OS_ROBIN
+	void     setQuantum( cnt_t _quantum ) {        tsk_setQuantum(this, _quantum); }
+	cnt_t    getQuantum( void )           { return tsk_getQuantum(this);         }
+#endif
+#if OS_TIMER_SLACK
+	void     setSlack ( cnt_t _slack )    {        tsk_setSlack  (this, _slack);   }
+	cnt_t    getSlack ( void )            { return tsk_getSlack  (this);         }
+#endif
+#if OS_TASK_RUNTIME
+	uint64_t getRuntime( void )           { return tsk_getRuntime(this);         }
+#endif
 	unsigned give     ( unsigned _flags ) { return tsk_give      (this, _flags); }
 	unsigned giveISR  ( unsigned _flags ) { return tsk_giveISR   (this, _flags); }
+#if OS_TSK_NOTIFY
+	uint32_t notify   ( unsigned _slot, uint32_t _value, unsigned _action = ntfSetBits ) { return tsk_notify   (this, _slot, _value, _action); }
+	uint32_t notifyISR( unsigned _slot, uint32_t _value, unsigned _action = ntfSetBits ) { return tsk_notifyISR(this, _slot, _value, _action); }
+	uint32_t notifyClear( unsigned _slot, uint32_t _bits ) { return tsk_notifyClear(this, _slot, _bits); }
+	uint32_t notifyGet( unsigned _slot )  { return tsk_notifyGet (this, _slot);   }
+#endif
 	unsigned suspend  ( void )            { return tsk_suspend   (this);         }
 	unsigned resume   ( void )            { return tsk_resume    (this);         }
 	unsigned resumeISR( void )            { return tsk_resumeISR (this);         }
@@ -1298,6 +1957,47 @@ struct startTaskT : public TaskT<size_>
 
 typedef startTaskT<OS_STACK_SIZE> startTask;
 
+/******************************************************************************
+ *
+ * Class             : BasicTask
+ *
+ * Description       : create and initialize basic task object
+ *                     basic task runs to completion on the stack shared by the basic tasks with the same priority
+ *
+ * Constructor parameters
+ *   prio            : initial task priority (any unsigned int value)
+ *   state           : task state (initial task function) doesn't have to be noreturn-type
+ *                     it will be executed into an infinite system-implemented loop
+ *
+ * Note              : only available when OS_BASIC_STACK > 0
+ *
+ ******************************************************************************/
+
+#if OS_BASIC_STACK
+
+struct BasicTask : public __tsk
+{
+	 BasicTask( const unsigned _prio, fun_t *_state ): __tsk _TSK_INIT(_prio, _state, 0, 0) {}
+	~BasicTask( void ) { assert(__tsk::hdr.id == ID_STOPPED); }
+
+	void     start    ( void )            {        tsk_start     (this);         }
+	void     startFrom( fun_t  * _state ) {        tsk_startFrom (this, _state); }
+	unsigned join     ( void )            { return tsk_join      (this);         }
+	void     kill     ( void )            {        tsk_kill      (this);         }
+	void     reset    ( void )            {        tsk_reset     (this);         }
+	unsigned give     ( unsigned _flags ) { return tsk_give      (this, _flags); }
+	unsigned giveISR  ( unsigned _flags ) { return tsk_giveISR   (this, _flags); }
+#if OS_TSK_NOTIFY
+	uint32_t notify   ( unsigned _slot, uint32_t _value, unsigned _action = ntfSetBits ) { return tsk_notify   (this, _slot, _value, _action); }
+	uint32_t notifyISR( unsigned _slot, uint32_t _value, unsigned _action = ntfSetBits ) { return tsk_notifyISR(this, _slot, _value, _action); }
+	uint32_t notifyClear( unsigned _slot, uint32_t _bits ) { return tsk_notifyClear(this, _slot, _bits); }
+	uint32_t notifyGet( unsigned _slot )  { return tsk_notifyGet (this, _slot);   }
+#endif
+	bool     operator!( void )            { return __tsk::hdr.id == ID_STOPPED;  }
+};
+
+#endif
+
 /******************************************************************************
  *
  * Namespace         : ThisTask
@@ -1324,6 +2024,18 @@ namespace ThisTask
 	static inline void     prio      ( unsigned _prio )                {        tsk_prio      (_prio);                 }
 	static inline unsigned getPrio   ( void )                          { return tsk_getPrio   ();                      }
 	static inline unsigned prio      ( void )                          { return tsk_getPrio   ();                      }
+#if OS_EDF_PRIO
+	static inline void     setDeadline( cnt_t  _time )                 {        tsk_setDeadline(_time);                }
+	static inline cnt_t    getDeadline( void )                         { return tsk_getDeadline();                     }
+#endif
+#if OS_ROBIN
+	static inline void     setQuantum( cnt_t _quantum )                {        tsk_setQuantum(System.cur, _quantum);  }
+	static inline cnt_t    getQuantum( void )                          { return tsk_getQuantum(System.cur);            }
+#endif
+#if OS_TIMER_SLACK
+	static inline void     setSlack  ( cnt_t _slack )                  {        tsk_setSlack  (System.cur, _slack);    }
+	static inline cnt_t    getSlack  ( void )                          { return tsk_getSlack  (System.cur);            }
+#endif
 	static inline void     sleepFor  ( cnt_t    _delay )               {        tsk_sleepFor  (_delay);                }
 	static inline void     sleepNext ( cnt_t    _delay )               {        tsk_sleepNext (_delay);                }
 	static inline void     sleepUntil( cnt_t    _time )                {        tsk_sleepUntil(_time);                 }
@@ -1332,6 +2044,11 @@ namespace ThisTask
 	static inline unsigned waitFor   ( unsigned _flags, cnt_t _delay ) { return tsk_waitFor   (_flags, _delay);        }
 	static inline unsigned waitUntil ( unsigned _flags, cnt_t _time )  { return tsk_waitUntil (_flags, _time);         }
 	static inline unsigned wait      ( unsigned _flags )               { return tsk_wait      (_flags);                }
+#if OS_TSK_NOTIFY
+	static inline unsigned notifyWaitFor  ( unsigned _slot, uint32_t _bits, char _mode, uint32_t *_value, cnt_t _delay ) { return tsk_notifyWaitFor  (_slot, _bits, _mode, _value, _delay); }
+	static inline unsigned notifyWaitUntil( unsigned _slot, uint32_t _bits, char _mode, uint32_t *_value, cnt_t _time )  { return tsk_notifyWaitUntil(_slot, _bits, _mode, _value, _time);  }
+	static inline unsigned notifyWait     ( unsigned _slot, uint32_t _bits, char _mode, uint32_t *_value )               { return tsk_notifyWait     (_slot, _bits, _mode, _value);         }
+#endif
 	static inline void     suspend   ( void )                          {        cur_suspend   ();                      }
 }
 
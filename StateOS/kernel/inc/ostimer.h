@@ -52,6 +52,17 @@ struct __tmr
 	cnt_t    start;
 	cnt_t    delay;
 	cnt_t    period;
+
+#if OS_TIMER_DAEMON
+	struct {
+	tmr_t  * next;  // next timer with pending callbacks
+	unsigned count; // number of callbacks pending for the timer daemon
+	bool     on;    // callback is executed by the timer daemon
+	}        dmn;
+	#define _TMR_DAEMON , { 0, 0, false }
+#else
+	#define _TMR_DAEMON
+#endif
 };
 
 /******************************************************************************
@@ -70,7 +81,7 @@ struct __tmr
  *
  ******************************************************************************/
 
-#define               _TMR_INIT( _state ) { _HDR_INIT(), _state, 0, 0, 0 }
+#define               _TMR_INIT( _state ) { _HDR_INIT(), _state, 0, 0, 0 _TMR_DAEMON }
 
 /******************************************************************************
  *
@@ -297,11 +308,19 @@ struct __tmr
  * Return            : current timer object
  *
  * Note              : use only in timer callback procedure
+ *                     also in the callback executed by the timer daemon
  *
  ******************************************************************************/
 
 __STATIC_INLINE
-tmr_t *tmr_thisISR( void ) { return (tmr_t *) WAIT.hdr.next; }
+tmr_t *tmr_thisISR( void )
+{
+#if OS_TIMER_DAEMON
+	if (DAEMON.cur && !port_isr_context())
+		return DAEMON.cur;
+#endif
+	return (tmr_t *) WAIT.hdr.next;
+}
 
 /******************************************************************************
  *
@@ -403,6 +422,7 @@ void tmr_delete( tmr_t *tmr );
  * Return            : none
  *
  * Note              : use only in thread mode
+ *                     a periodic timer served later than its next period expires once for every missed period
  *
  ******************************************************************************/
 
@@ -447,6 +467,7 @@ void tmr_startFor( tmr_t *tmr, cnt_t delay ) { tmr_start(tmr, delay, 0); }
  * Return            : none
  *
  * Note              : use only in thread mode
+ *                     a periodic timer served later than its next period expires once for every missed period
  *
  ******************************************************************************/
 
@@ -475,6 +496,7 @@ void tmr_startPeriodic( tmr_t *tmr, cnt_t period ) { tmr_start(tmr, period, peri
  * Return            : none
  *
  * Note              : use only in thread mode
+ *                     a periodic timer served later than its next period expires once for every missed period
  *
  ******************************************************************************/
 
@@ -658,6 +680,76 @@ unsigned tmr_waitUntil( tmr_t *tmr, cnt_t time );
 __STATIC_INLINE
 unsigned tmr_wait( tmr_t *tmr ) { return tmr_waitFor(tmr, INFINITE); }
 
+/******************************************************************************
+ *
+ * Name              : tmr_setDeferred
+ *
+ * Description       : set the execution context of the timer callback procedure
+ *
+ * Parameters
+ *   tmr             : pointer to timer object
+ *   deferred        : true:  callback procedure is executed by the timer daemon task (priority OS_TIMER_DAEMON)
+ *                            the timer interrupt only queues the expired timer; expirations are not lost,
+ *                            the callback is executed once for every expiration
+ *                     false: callback procedure is executed in the timer interrupt (default)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_TIMER_DAEMON > 0
+ *                     tmr_flipISR and tmr_delayISR used in the deferred callback take effect from the next expiration
+ *
+ ******************************************************************************/
+
+#if OS_TIMER_DAEMON
+void tmr_setDeferred( tmr_t *tmr, bool deferred );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tmr_setSlack
+ *
+ * Description       : set the slack of the timer: tolerated delay of its expiration
+ *                     expirations of the timers with overlapping windows are served together in one pass of the timer handler
+ *
+ * Parameters
+ *   tmr             : pointer to timer object
+ *   slack           : tolerated delay of the expiration (in ticks); 0: the timer expires exactly at its deadline (default)
+ *
+ * Return            : none
+ *
+ * Note              : use only in thread mode
+ *                     only available when OS_TIMER_SLACK > 0
+ *                     the slack does not shift the deadlines of the periodic timer, so the period does not drift
+ *                     the new value is used from the next start of the timer
+ *
+ ******************************************************************************/
+
+#if OS_TIMER_SLACK
+void tmr_setSlack( tmr_t *tmr, cnt_t slack );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : tmr_getSlack
+ *
+ * Description       : get the slack of the timer
+ *
+ * Parameters
+ *   tmr             : pointer to timer object
+ *
+ * Return            : tolerated delay of the expiration (in ticks)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only available when OS_TIMER_SLACK > 0
+ *
+ ******************************************************************************/
+
+#if OS_TIMER_SLACK
+__STATIC_INLINE
+cnt_t tmr_getSlack( tmr_t *tmr ) { return tmr->hdr.slack; }
+#endif
+
 /******************************************************************************
  *
  * Name              : tmr_flipISR
@@ -731,6 +823,13 @@ struct staticTimer : public __tmr
 	void startNext    ( cnt_t _delay )                               {        tmr_startNext    (this, _delay);                  }
 	void startUntil   ( cnt_t _time )                                {        tmr_startUntil   (this, _time);                   }
 	void stop         ( void )                                       {        tmr_stop         (this);                          }
+#if OS_TIMER_DAEMON
+	void setDeferred  ( bool _deferred )                             {        tmr_setDeferred  (this, _deferred);               }
+#endif
+#if OS_TIMER_SLACK
+	void  setSlack    ( cnt_t _slack )                               {        tmr_setSlack     (this, _slack);                  }
+	cnt_t getSlack    ( void )                                       { return tmr_getSlack     (this);                          }
+#endif
 
 	unsigned take     ( void )                                       { return tmr_take         (this);                          }
 	unsigned tryWait  ( void )                                       { return tmr_tryWait      (this);                          }
@@ -763,7 +862,7 @@ struct Timer : public staticTimer
 	void  startFrom( cnt_t _delay, cnt_t _period, FUN_t _state ) { fun_ = _state; tmr_startFrom(this, _delay, _period, run_); }
 
 	static
-	void  run_( void ) { ((Timer *)WAIT.hdr.next)->fun_(); }
+	void  run_( void ) { ((Timer *)tmr_thisISR())->fun_(); }
 	FUN_t fun_;
 #else
 	Timer( FUN_t _state ): staticTimer(_state) {}
@@ -872,7 +971,7 @@ struct startTimerUntil : public Timer
 namespace ThisTimer
 {
 #if OS_FUNCTIONAL
-	static inline void flipISR ( FUN_t _state ) { ((Timer *)WAIT.hdr.next)->fun_ = _state;
+	static inline void flipISR ( FUN_t _state ) { ((Timer *)tmr_thisISR())->fun_ = _state;
 	                                              tmr_flipISR (Timer::run_);           }
 #else
 	static inline void flipISR ( FUN_t _state ) { tmr_flipISR (_state);                }
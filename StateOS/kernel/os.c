@@ -30,6 +30,7 @@
  ******************************************************************************/
 
 #include "oskernel.h"
+#include "inc/ostask.h"
 #include "inc/oscriticalsection.h"
 
 /* -------------------------------------------------------------------------- */
@@ -48,3 +49,111 @@ cnt_t sys_time( void )
 }
 
 /* -------------------------------------------------------------------------- */
+
+#if OS_TIME_NSEC
+
+/* -------------------------------------------------------------------------- */
+uint64_t sys_timeNs( void )
+/* -------------------------------------------------------------------------- */
+{
+	uint64_t cnt = core_clk_time();
+
+	return cnt / (RUN_FREQUENCY) * 1000000000ULL + cnt % (RUN_FREQUENCY) * 1000000000ULL / (RUN_FREQUENCY);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TASK_RUNTIME
+
+/* -------------------------------------------------------------------------- */
+uint64_t sys_getIdle( void )
+/* -------------------------------------------------------------------------- */
+{
+	uint64_t idle;
+
+	sys_lock();
+	{
+		core_run_account();
+		idle = IDLE.runtime;
+	}
+	sys_unlock();
+
+	return idle;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned sys_getLoad( void )
+/* -------------------------------------------------------------------------- */
+{
+	static uint64_t last_run [OS_CPU_COUNT];
+	static uint64_t last_idle[OS_CPU_COUNT];
+	uint64_t run, idle;
+
+	sys_lock();
+	{
+		core_run_account();
+		run  = System.run    - last_run [port_cpu_id()];
+		idle = IDLE.runtime  - last_idle[port_cpu_id()];
+		last_run [port_cpu_id()] = System.run;
+		last_idle[port_cpu_id()] = IDLE.runtime;
+	}
+	sys_unlock();
+
+	return run ? (unsigned)((run - idle) * 100 / run) : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TIMER_SLACK
+
+/* -------------------------------------------------------------------------- */
+unsigned sys_getMerged( void )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned cnt;
+
+	sys_lock();
+	{
+		cnt = MERGED;
+	}
+	sys_unlock();
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_LOCK_STATS
+
+/* -------------------------------------------------------------------------- */
+uint32_t sys_getLockHold( unsigned fun )
+/* -------------------------------------------------------------------------- */
+{
+	uint32_t hold;
+
+	assert(fun < LCK_COUNT);
+
+	sys_lock();
+	{
+		hold = core_hld_max(fun);
+	}
+	sys_unlock();
+
+	return hold;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
@@ -46,6 +46,7 @@
 
 #include "oskernel.h"
 #include "osalloc.h"
+#include "ostrace.h"
 #include "inc/oscriticalsection.h"
 #include "inc/osspinlock.h"
 #include "inc/osonceflag.h"
@@ -66,6 +67,8 @@
 #include "inc/osjobqueue.h"
 #include "inc/ostimer.h"
 #include "inc/ostask.h"
+#include "inc/osbudget.h"
+#include "inc/osdeferredroutine.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -109,8 +112,127 @@ cnt_t sys_time( void );
 __STATIC_INLINE
 cnt_t sys_timeISR( void ) { return sys_time(); }
 
+/******************************************************************************
+ *
+ * Name              : sys_timeNs
+ * ISR alias         : sys_timeNsISR
+ *
+ * Description       : return current value of the monotonic clock in nanoseconds
+ *                     sub-tick time is interpolated with the runtime counter
+ *
+ * Parameters        : none
+ *
+ * Return            : time elapsed since the first call of the function (in nanoseconds)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     the clock is read without any critical section, interrupts are never disabled
+ *                     (except for the first call, which starts the clock)
+ *                     resolution is given by the frequency of the runtime counter (RUN_FREQUENCY)
+ *                     only available when OS_TIME_NSEC > 0
+ *
+ ******************************************************************************/
+
+#if OS_TIME_NSEC
+
+uint64_t sys_timeNs( void );
+
+__STATIC_INLINE
+uint64_t sys_timeNsISR( void ) { return sys_timeNs(); }
+
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sys_getIdle
+ *
+ * Description       : return processor time used by the idle process of the current processor
+ *
+ * Parameters        : none
+ *
+ * Return            : idle time in units of the runtime counter
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only available when OS_TASK_RUNTIME > 0
+ *
+ ******************************************************************************/
+
+#if OS_TASK_RUNTIME
+uint64_t sys_getIdle( void );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sys_getLoad
+ *
+ * Description       : return load of the current processor since the previous call of the function
+ *
+ * Parameters        : none
+ *
+ * Return            : percentage (0..100) of the processor time used by tasks other than the idle process
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only available when OS_TASK_RUNTIME > 0
+ *
+ ******************************************************************************/
+
+#if OS_TASK_RUNTIME
+unsigned sys_getLoad( void );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sys_getMerged
+ *
+ * Description       : return number of timer expirations and task timeouts served together with another one
+ *                     in one pass of the timer handler, i.e. without a separate timer interrupt
+ *
+ * Parameters        : none
+ *
+ * Return            : number of merged expirations since the system start
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     only available when OS_TIMER_SLACK > 0
+ *
+ ******************************************************************************/
+
+#if OS_TIMER_SLACK
+unsigned sys_getMerged( void );
+#endif
+
+/******************************************************************************
+ *
+ * Name              : sys_getLockHold
+ *
+ * Description       : return the longest time of the critical section recorded for the bounded kernel loop 'fun'
+ *                     since the previous call of the function
+ *                     (up to the first interrupt window, between the windows and after the last one)
+ *
+ * Parameters
+ *   fun             : identifier of the kernel loop
+ *                     LCK_WAKEUP:  broadcast wakeup of the blocked queue (evt_give, bar_wait, xxx_kill)
+ *                     LCK_FLAG:    scan of the tasks waiting for the flags (flg_give)
+ *                     LCK_STREAM:  transfer of the stream buffer data to the waiting tasks (stm_give, stm_take)
+ *                     LCK_HEAP:    walk through the system heap (sys_alloc, sys_free)
+ *                     LCK_DESTROY: destruction of the stopped tasks (tsk_delete, detached tasks)
+ *
+ * Return            : time in units of the runtime counter (RUN_FREQUENCY)
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     the window is not opened in a nested critical section, e.g. the heap walk of xxx_create
+ *                     only available when OS_LOCK_STATS > 0
+ *
+ ******************************************************************************/
+
+#if OS_LOCK_STATS
+uint32_t sys_getLockHold( unsigned fun );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
 
+/* -------------------------------------------------------------------------- */
+
+#include "inc/oscoroutine.h"
+
 #endif//__STATEOS
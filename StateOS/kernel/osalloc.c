@@ -44,10 +44,30 @@ seg_t Heap[SEG_SIZE(OS_HEAP_SIZE)+1] =
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_LOCK_SPAN
+
+static
+unsigned HeapSeq = 0; // number of heap operations; the walk is restarted after the heap has been used in the interrupt window
+
+static
+bool priv_heap_window( hld_t *hld )
+{
+	unsigned seq = HeapSeq;
+
+	core_hld_window(hld);
+
+	return seq != HeapSeq;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 void *sys_alloc( size_t size )
 {
 	seg_t *mem;
 	seg_t *nxt;
+	hld_t  hld;
 
 	assert(SEG_SIZE(size));
 
@@ -55,8 +75,18 @@ void *sys_alloc( size_t size )
 
 	sys_lock();
 	{
+#if OS_LOCK_SPAN
+		HeapSeq++;
+#endif
+		core_hld_init(&hld, LCK_HEAP, core_lck_saved());
+
 		for (mem = Heap; mem; mem = mem->next)
 		{
+#if OS_LOCK_SPAN
+			if (core_hld_tick(&hld) && priv_heap_window(&hld))
+		//	the heap has been used in the interrupt window
+				mem = Heap;
+#endif
 			if (mem->owner != mem)
 		//	memory segment has already been allocated
 				continue;
@@ -83,6 +113,8 @@ void *sys_alloc( size_t size )
 		//	memory segment has been successfully allocated
 			break;
 		}
+
+		core_hld_done(&hld);
 	}
 	sys_unlock();
 
@@ -97,11 +129,22 @@ void sys_free( void *base )
 {
 	seg_t *mem;
 	seg_t *seg = (seg_t *)base - 1;
+	hld_t  hld;
 
 	sys_lock();
 	{
+#if OS_LOCK_SPAN
+		HeapSeq++;
+#endif
+		core_hld_init(&hld, LCK_HEAP, core_lck_saved());
+
 		for (mem = Heap; mem; mem = mem->next)
 		{
+#if OS_LOCK_SPAN
+			if (core_hld_tick(&hld) && priv_heap_window(&hld))
+		//	the heap has been used in the interrupt window
+				mem = Heap;
+#endif
 			if (mem != seg)
 		//	this is not the memory segment we are looking for
 				continue;
@@ -110,6 +153,8 @@ void sys_free( void *base )
 		//	memory segment has been successfully released
 			break;
 		}
+
+		core_hld_done(&hld);
 	}
 	sys_unlock();
 }
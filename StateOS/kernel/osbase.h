@@ -69,7 +69,130 @@ typedef uint64_t     cnt_t;
 
 /* -------------------------------------------------------------------------- */
 
+#ifndef OS_PRIO_LEVELS
+#define OS_PRIO_LEVELS    0
+#endif
+
+#if     OS_PRIO_LEVELS > 1024
+#error  Invalid OS_PRIO_LEVELS value!
+#endif
+
+#ifndef OS_TIMER_WHEEL
+#define OS_TIMER_WHEEL    0
+#endif
+
+#if     OS_TIMER_WHEEL > 1024 || OS_TIMER_WHEEL == 1 || (OS_TIMER_WHEEL & (OS_TIMER_WHEEL - 1))
+#error  Invalid OS_TIMER_WHEEL value!
+#endif
+
+#ifndef OS_TIMER_LEVELS
+#define OS_TIMER_LEVELS   1
+#endif
+
+#if     OS_TIMER_LEVELS < 1 || OS_TIMER_LEVELS > 8
+#error  Invalid OS_TIMER_LEVELS value!
+#endif
+
+#ifndef OS_CPU_COUNT
+#define OS_CPU_COUNT      1
+#endif
+
+#if     OS_CPU_COUNT < 1 || OS_CPU_COUNT > 32
+#error  Invalid OS_CPU_COUNT value!
+#endif
+
+#ifndef OS_DYNAMIC_TICK
+#define OS_DYNAMIC_TICK   0
+#endif
+
+#if     OS_DYNAMIC_TICK && OS_CPU_COUNT > 1
+#error  OS_DYNAMIC_TICK requires OS_CPU_COUNT == 1!
+#endif
+
+#ifndef OS_TASK_RUNTIME
+#define OS_TASK_RUNTIME   0
+#endif
+
+#ifndef OS_TRACE
+#define OS_TRACE          0
+#endif
+
+#if     OS_TRACE & (OS_TRACE - 1)
+#error  OS_TRACE must be a power of 2!
+#endif
+
+#ifndef OS_EDF_PRIO
+#define OS_EDF_PRIO       0
+#endif
+
+#if     OS_EDF_PRIO && OS_PRIO_LEVELS && OS_EDF_PRIO >= OS_PRIO_LEVELS - 1
+#error  OS_EDF_PRIO must be lower than OS_PRIO_LEVELS-1!
+#endif
+
+#ifndef OS_BUDGET
+#define OS_BUDGET         0
+#endif
+
+#if     OS_BUDGET && HW_TIMER_SIZE
+#error  OS_BUDGET requires HW_TIMER_SIZE == 0!
+#endif
+
+#ifndef OS_BASIC_STACK
+#define OS_BASIC_STACK    0
+#endif
+
+#ifndef OS_TIMER_DAEMON
+#define OS_TIMER_DAEMON   0
+#endif
+
+#ifndef OS_TIMER_SLACK
+#define OS_TIMER_SLACK    0
+#endif
+
+#ifndef OS_TIME_NSEC
+#define OS_TIME_NSEC      0
+#endif
+
+#if     OS_TIME_NSEC && OS_TIMER_SIZE < 32
+#error  OS_TIME_NSEC requires OS_TIMER_SIZE >= 32!
+#endif
+
+#ifndef OS_LOCK_SPAN
+#define OS_LOCK_SPAN      0
+#endif
+
+#if     OS_LOCK_SPAN && OS_CPU_COUNT > 1
+#error  OS_LOCK_SPAN requires OS_CPU_COUNT == 1!
+#endif
+
+#ifndef OS_LOCK_STATS
+#define OS_LOCK_STATS     0
+#endif
+
+#ifndef OS_DSR_LEVELS
+#define OS_DSR_LEVELS     0
+#endif
+
+#ifndef OS_DSR_PRIO
+#define OS_DSR_PRIO       1
+#endif
+
+#ifndef OS_ISR_LOCKFREE
+#define OS_ISR_LOCKFREE   0
+#endif
+
+#ifndef OS_TSK_NOTIFY
+#define OS_TSK_NOTIFY     0
+#endif
+
+#if     OS_ISR_LOCKFREE && OS_TSK_NOTIFY > 32
+#error  OS_ISR_LOCKFREE requires OS_TSK_NOTIFY <= 32!
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 typedef struct __mtx mtx_t, * const mtx_id;
+typedef struct __bgt bgt_t, * const bgt_id; // budget reservation
 typedef struct __tmr tmr_t, * const tmr_id; // timer
 typedef struct __tsk tsk_t, * const tsk_id; // task
 typedef         void fun_t(); // timer/task procedure
@@ -111,6 +234,29 @@ typedef struct __obj
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_ISR_LOCKFREE
+
+// posts of the interrupt handlers recorded in the object without disabling the interrupts
+// and resolved by the kernel handler (core_tsk_handler)
+
+typedef struct __pnd pnd_t;
+
+typedef void pnd_fun( pnd_t *pnd, unsigned val ); // procedure resolving the posts in the critical section
+
+struct __pnd
+{
+	pnd_t  * next;  // next object with pending posts
+	pnd_fun* fun;   // procedure resolving the posts
+	volatile
+	unsigned pend;  // posts recorded by the interrupt handlers (counter or bit mask)
+};
+
+#define               _PND_INIT() { 0, 0, 0 }
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 __STATIC_INLINE
 void core_obj_init( obj_t *obj )
 {
@@ -127,10 +273,16 @@ typedef struct __hdr
 	void   * prev;  // previous object (timer / task) in the READY queue
 	void   * next;  // next object (timer / task) in the READY queue
 	tid_t    id;    // timer / task id
+#if OS_TIMER_SLACK
+	cnt_t    slack; // tolerated delay of the expiration of the timer / timeout of the task
+	#define _HDR_SLACK , 0
+#else
+	#define _HDR_SLACK
+#endif
 
 }	hdr_t;
 
-#define               _HDR_INIT() { _OBJ_INIT(), 0, 0, ID_STOPPED }
+#define               _HDR_INIT() { _OBJ_INIT(), 0, 0, ID_STOPPED _HDR_SLACK }
 
 /* -------------------------------------------------------------------------- */
 
@@ -149,13 +301,24 @@ void core_hdr_init( hdr_t *hdr )
 typedef struct __sys
 {
 	tsk_t  * cur;   // pointer to the current task control block
+#if OS_CPU_COUNT > 1
+	tsk_t  * idle;  // pointer to the idle task and tasks' queue of the processor
+#endif
 #if HW_TIMER_SIZE < OS_TIMER_SIZE
 	volatile
 	cnt_t    cnt;   // system timer counter
 #endif
-	tsk_t  * wai;   // queue of tasks waiting for an event / flags
 	tsk_t  * dly;   // queue of sleeping and suspended tasks
 	tsk_t  * des;   // queue of tasks waiting for destruction
+#if OS_TASK_RUNTIME
+	uint32_t rtm;   // value of the runtime counter at the last accounting
+	uint64_t run;   // total runtime counted by the processor
+#endif
+	unsigned hold;  // scheduler lock counter; task switching is deferred while it is nonzero
+	bool     skip;  // task switch deferred by the scheduler lock, forced when the lock is released
+#if OS_LOCK_SPAN
+	unsigned seq;   // number of changes of the blocked queues; kernel loops revalidate their state with it
+#endif
 
 }	sys_t;
 
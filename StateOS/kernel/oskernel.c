@@ -33,6 +33,10 @@
 #include "inc/ostimer.h"
 #include "inc/ostask.h"
 #include "inc/osmutex.h"
+#include "inc/osbudget.h"
+#include "inc/oscriticalsection.h"
+#include "ostrace.h"
+#include "osalloc.h"
 
 /* -------------------------------------------------------------------------- */
 // SYSTEM INTERNAL SERVICES
@@ -71,410 +75,1718 @@ void priv_rdy_remove( hdr_t *hdr )
 	prv->next = nxt;
 }
 
-/* -------------------------------------------------------------------------- */
-// SYSTEM TIMER SERVICES
 /* -------------------------------------------------------------------------- */
 
-tmr_t WAIT = { .hdr={ .prev=&WAIT, .next=&WAIT, .id=ID_TIMER }, .delay=INFINITE }; // timers queue
+#if OS_PRIO_LEVELS || OS_TIMER_WHEEL
 
-/* -------------------------------------------------------------------------- */
+// return index of the least significant bit set in the non-zero value 'map'
 
-static
-void priv_tmr_insert( tmr_t *tmr, tid_t id )
+static inline
+unsigned priv_map_first( uint32_t map )
 {
-	tmr_t *nxt = &WAIT;
-
-	if (tmr->delay != INFINITE)
-		do nxt = nxt->hdr.next;
-		while (nxt->delay < (cnt_t)(tmr->start + tmr->delay - nxt->start));
-
-	tmr->hdr.id = id;
-	priv_rdy_insert(&tmr->hdr, &nxt->hdr);
+	map &= ~map + 1;
+#if   defined(__CLZ)
+	return 31U - __CLZ(map);
+#elif defined(__GNUC__)
+	return 31U - (unsigned)__builtin_clz(map);
+#else
+	unsigned idx = 0;
+	if (map & UINT32_C(0xFFFF0000)) idx += 16;
+	if (map & UINT32_C(0xFF00FF00)) idx +=  8;
+	if (map & UINT32_C(0xF0F0F0F0)) idx +=  4;
+	if (map & UINT32_C(0xCCCCCCCC)) idx +=  2;
+	if (map & UINT32_C(0xAAAAAAAA)) idx +=  1;
+	return idx;
+#endif
 }
 
-/* -------------------------------------------------------------------------- */
-
-static
-void priv_tmr_remove( tmr_t *tmr )
-{
-	tmr->hdr.id = ID_STOPPED;
-	priv_rdy_remove(&tmr->hdr);
-}
+#endif
 
+/* -------------------------------------------------------------------------- */
+// SYSTEM TIMER SERVICES
 /* -------------------------------------------------------------------------- */
 
-void core_tmr_insert( tmr_t *tmr, tid_t id )
-{
-	priv_tmr_insert(tmr, id);
-	port_tmr_force();
-}
+tmr_t WAIT = { .hdr={ .prev=&WAIT, .next=&WAIT, .id=ID_TIMER }, .delay=INFINITE }; // timers queue
+#if OS_TIMER_DAEMON
+dmn_t DAEMON = { 0 }; // timer daemon data
+#endif
+#if OS_TIMER_SLACK
+unsigned MERGED = 0;  // number of timer expirations served together with another one
+#endif
 
 /* -------------------------------------------------------------------------- */
 
-void core_tmr_remove( tmr_t *tmr )
+// return the number of ticks left to the end of the countdown of timer 'tmr'; 0 if the timer is already late
+
+static inline
+cnt_t priv_tmr_left( tmr_t *tmr, cnt_t now )
 {
-	priv_tmr_remove(tmr);
+	cnt_t time = (cnt_t)(now - tmr->start);
+
+	return tmr->delay > time ? (cnt_t)(tmr->delay - time) : 0;
 }
 
 /* -------------------------------------------------------------------------- */
-
-#if HW_TIMER_SIZE
+// the timers are compared by the time left from now, so a timer inserted after its deadline
+// (e.g. tsk_sleepNext with an old start) is not placed behind the timers started after that deadline
 
 static
-bool priv_tmr_expired( tmr_t *tmr )
+void priv_tmr_sort( tmr_t *tmr )
 {
-	port_tmr_stop();
-
-	if (tmr->delay == INFINITE)
-	return false; // return if timer counting indefinitely
-
-	if (tmr->delay <= (cnt_t)(core_sys_time() - tmr->start))
-	return true;  // return if timer finished counting
-
-	port_tmr_start((cnt_t)(tmr->start + tmr->delay));
+	tmr_t *nxt = &WAIT;
+	cnt_t  now;
+	cnt_t  left;
 
-	if (tmr->delay >  (cnt_t)(core_sys_time() - tmr->start))
-	return false; // return if timer still counts
+	if (tmr->delay != INFINITE)
+	{
+		now  = core_sys_time();
+		left = priv_tmr_left(tmr, now);
 
-	port_tmr_stop();
+		do nxt = nxt->hdr.next;
+		while (nxt->delay != INFINITE && priv_tmr_left(nxt, now) < left);
+	}
 
-	return true;  // however timer finished counting
+	priv_rdy_insert(&tmr->hdr, &nxt->hdr);
 }
 
 /* -------------------------------------------------------------------------- */
 
-#else
+#if OS_TIMER_SLACK
+
+// return the delay of timer 'tmr' from the head of WAIT extended by its slack
+// the extension is limited by the slack of every timer finishing counting within the window,
+// so all these timers are served together in one pass of the timer handler and none of them is late beyond its slack
 
 static
-bool priv_tmr_expired( tmr_t *tmr )
+cnt_t priv_tmr_slack( tmr_t *tmr )
 {
-	if (tmr->delay >= (cnt_t)(core_sys_time() - tmr->start + 1))
-	return false; // return if timer still counts or counting indefinitely
-
-	return true;  // timer finished counting
-}
+	tmr_t *nxt;
+	cnt_t  win = tmr->hdr.slack;
+	cnt_t  off;
 
-#endif
-
-/* -------------------------------------------------------------------------- */
+	if (tmr->delay == INFINITE || win == 0)
+	return tmr->delay;
 
-static
-void priv_tmr_wakeup( tmr_t *tmr, unsigned event )
-{
-	if (tmr->state)
-		tmr->state();
+	for (nxt = tmr->hdr.next; nxt->delay != INFINITE; nxt = nxt->hdr.next)
+	{
+		off = (cnt_t)(nxt->start + nxt->delay - tmr->start - tmr->delay);
+		if (off > win)
+			break;
+		if (nxt->hdr.slack < win - off)
+			win = off + nxt->hdr.slack;
+	}
 
-	core_tmr_remove(tmr);
-	if (tmr->delay >= (cnt_t)(core_sys_time() - tmr->start + 1))
-		priv_tmr_insert(tmr, ID_TIMER);
+	if (win >= (cnt_t)(INFINITE - tmr->delay))
+	return tmr->delay;
 
-	core_all_wakeup(tmr->hdr.obj.queue, event);
+	return tmr->delay + win;
 }
 
-/* -------------------------------------------------------------------------- */
+#else
 
-void core_tmr_handler( void )
+static inline
+cnt_t priv_tmr_slack( tmr_t *tmr )
 {
-	tmr_t *tmr;
-
-	assert_stk_integrity();
-
-	port_set_lock();
-	{
-		while (priv_tmr_expired(tmr = WAIT.hdr.next))
-		{
-			tmr->start += tmr->delay;
-
-			if (tmr->hdr.id == ID_TIMER)
-			{
-				tmr->delay = tmr->period;
-
-				priv_tmr_wakeup((tmr_t *)tmr, E_SUCCESS);
-			}
-			else  /* hdr.id == ID_BLOCKED */
-				core_tsk_wakeup((tsk_t *)tmr, E_TIMEOUT);
-		}
-	}
-	port_clr_lock();
+	return tmr->delay;
 }
 
-/* -------------------------------------------------------------------------- */
-// SYSTEM TASK SERVICES
-/* -------------------------------------------------------------------------- */
-
-#ifndef MAIN_TOP
-static  stk_t     MAIN_STK[STK_SIZE(OS_STACK_SIZE)];
-#define MAIN_TOP (MAIN_STK+STK_SIZE(OS_STACK_SIZE))
 #endif
 
-static  union  { stk_t STK[STK_SIZE(OS_IDLE_STACK)];
-        struct { char  stk[STK_OVER(OS_IDLE_STACK)-sizeof(ctx_t)]; ctx_t ctx; } CTX; }
-        IDLE_STACK = { .CTX = { .ctx = _CTX_INIT(core_tsk_loop) } };
-#define IDLE_STK (void *)(&IDLE_STACK)
-#define IDLE_SP  (void *)(&IDLE_STACK.CTX.ctx)
+/* -------------------------------------------------------------------------- */
 
-tsk_t MAIN = { .hdr={ .prev=&IDLE, .next=&IDLE, .id=ID_READY }, .stack=MAIN_TOP, .basic=OS_MAIN_PRIO, .prio=OS_MAIN_PRIO }; // main task
-tsk_t IDLE = { .hdr={ .prev=&MAIN, .next=&MAIN, .id=ID_IDLE  }, .state=core_tsk_idle, .stack=IDLE_STK, .size=OS_IDLE_STACK, .sp=IDLE_SP }; // idle task and tasks queue
-sys_t System = { .cur=&MAIN };
+#if OS_TIMER_WHEEL == 0
 
 /* -------------------------------------------------------------------------- */
 
 static
-void priv_tsk_insert( tsk_t *tsk )
+void priv_tmr_insert( tmr_t *tmr, tid_t id )
 {
-	tsk_t *nxt = &IDLE;
-#if OS_ROBIN && HW_TIMER_SIZE == 0
-	tsk->slice = 0;
-#endif
-	if (tsk->prio)
-		do nxt = nxt->hdr.next;
-		while (tsk->prio <= nxt->prio);
-
-	priv_rdy_insert(&tsk->hdr, &nxt->hdr);
+	tmr->hdr.id = id;
+	priv_tmr_sort(tmr);
 }
 
 /* -------------------------------------------------------------------------- */
 
 static
-void priv_tsk_remove( tsk_t *tsk )
+void priv_tmr_remove( tmr_t *tmr )
 {
-	priv_rdy_remove(&tsk->hdr);
+	tmr->hdr.id = ID_STOPPED;
+	priv_rdy_remove(&tmr->hdr);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void core_tsk_insert( tsk_t *tsk )
+tmr_t *core_tmr_next( tmr_t *tmr )
 {
-	tsk->hdr.id = ID_READY;
-	priv_tsk_insert(tsk);
-	if (tsk == IDLE.hdr.next)
-		port_ctx_switch();
+	return tmr->hdr.next;
 }
 
 /* -------------------------------------------------------------------------- */
 
-void core_tsk_remove( tsk_t *tsk )
+static inline
+void priv_whl_collect( void )
 {
-	tsk->hdr.id = ID_STOPPED;
-	priv_tsk_remove(tsk);
-	if (tsk == System.cur)
-		priv_ctx_switchNow();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void core_ctx_init( tsk_t *tsk )
+static inline
+bool priv_whl_expired( void )
 {
-#ifdef DEBUG
-	memset(tsk->stack, 0xFF, tsk->size);
-#endif
-	tsk->sp = (ctx_t *)STK_CROP(tsk->stack, tsk->size) - 1;
-	port_ctx_init(tsk->sp, core_tsk_loop);
+	return false;
 }
 
 /* -------------------------------------------------------------------------- */
 
-void core_ctx_switch( void )
-{
-	tsk_t *cur = IDLE.hdr.next;
-	tsk_t *nxt = cur->hdr.next;
-	if (nxt->prio == cur->prio)
-		port_ctx_switch();
-}
+#else //OS_TIMER_WHEEL
 
 /* -------------------------------------------------------------------------- */
+// timers with a deadline within half of the counter range are placed by their deadline into the wheel slots,
+// so neither insertion nor removal searches anything; the level of the timer is given by the most significant
+// digit in which its deadline differs from the time of the wheel, the slot is given by the value of this digit
+// slots passed by the system time are served: expired timers are moved to WAIT, the others to the lower levels
+// WAIT holds expired timers and timers counting indefinitely or too long for the wheel, sorted as before,
+// so WAIT.hdr.next is still the timer being served
+
+#define WHEEL_BITS  ((OS_TIMER_WHEEL) >= 1024 ? 10 : (OS_TIMER_WHEEL) >= 512 ? 9 : (OS_TIMER_WHEEL) >= 256 ? 8 : \
+                     (OS_TIMER_WHEEL) >=  128 ?  7 : (OS_TIMER_WHEEL) >=  64 ? 6 : (OS_TIMER_WHEEL) >=  32 ? 5 : \
+                     (OS_TIMER_WHEEL) >=   16 ?  4 : (OS_TIMER_WHEEL) >=   8 ? 3 : (OS_TIMER_WHEEL) >=   4 ? 2 : 1)
+
+#if (OS_TIMER_LEVELS) * WHEEL_BITS >= OS_TIMER_SIZE
+#error  Invalid OS_TIMER_LEVELS value for the size of the system timer counter!
+#endif
 
-void core_tsk_loop( void )
+#define WHEEL_WORDS (((OS_TIMER_WHEEL)+31)/32)
+#define WHEEL_SHIFT( lvl ) ((lvl) * WHEEL_BITS)
+#define WHEEL_MASK( lvl ) ((cnt_t)(((cnt_t)1 << WHEEL_SHIFT(lvl)) - 1))
+#define WHEEL_SLOT( time, lvl ) ((unsigned)((time) >> WHEEL_SHIFT(lvl)) & ((OS_TIMER_WHEEL)-1))
+
+static struct
 {
-	for (;;)
-	{
-		port_clr_lock();
-		System.cur->state();
-		port_set_lock();
-		core_ctx_switch();
-	}
-}
+	cnt_t    time;                                   // the wheel has been served up to this time
+	uint32_t lvl;                                    // bitmap of non-empty levels
+	uint32_t grp[OS_TIMER_LEVELS];                   // bitmap of non-empty words of the slots' bitmap
+	uint32_t map[OS_TIMER_LEVELS][WHEEL_WORDS];      // bitmap of occupied slots
+	hdr_t    slot[OS_TIMER_LEVELS][OS_TIMER_WHEEL];  // roots of the slots' queues
+}	WHEEL;
 
 /* -------------------------------------------------------------------------- */
+// return the first occupied slot of level 'lvl' starting cyclically from 'pos'; OS_TIMER_WHEEL if the level is empty
 
-void core_tsk_append( tsk_t *tsk, tsk_t **que )
+static
+unsigned priv_whl_find( unsigned lvl, unsigned pos )
 {
-	tsk_t *nxt = *que;
-	tsk->guard = que;
+	unsigned idx = pos / 32;
+	uint32_t map = WHEEL.map[lvl][idx] & (~UINT32_C(0) << (pos % 32));
 
-	while (nxt && tsk->prio <= nxt->prio)
+	if (map == 0)
 	{
-		que = &nxt->hdr.obj.queue;
-		nxt = *que;
+		if (WHEEL.grp[lvl] == 0)
+			return OS_TIMER_WHEEL;
+		map = WHEEL.grp[lvl] & (~UINT32_C(1) << idx);
+		if (map == 0)
+			map = WHEEL.grp[lvl];
+		idx = priv_map_first(map);
+		map = WHEEL.map[lvl][idx];
 	}
 
-	if (nxt)
-		nxt->back = &tsk->hdr.obj.queue;
-	tsk->back = que;
-	tsk->hdr.obj.queue = nxt;
-	*que = tsk;
+	return idx * 32 + priv_map_first(map);
 }
 
 /* -------------------------------------------------------------------------- */
+// insert timer 'tmr' into the wheel; return false if timer has expired or counts too long for the wheel
 
-void core_tsk_unlink( tsk_t *tsk, unsigned event )
+static
+bool priv_whl_insert( tmr_t *tmr )
 {
-	tsk_t**que = tsk->back;
-	tsk_t *nxt = tsk->hdr.obj.queue;
-	tsk->event = event;
-	tsk->guard = 0;
+	cnt_t    time = tmr->start + tmr->delay;
+	cnt_t    diff = time ^ WHEEL.time;
+	unsigned lvl  = 0;
+	unsigned pos;
+	hdr_t  * slot;
 
-	if (nxt)
-		nxt->back = que;
-	*que = nxt;
-}
+	if (tmr->delay == INFINITE || (cnt_t)(time - WHEEL.time - 1) >= ((CNT_MAX)>>1))
+		return false;
 
-/* -------------------------------------------------------------------------- */
+	while (lvl + 1 < (OS_TIMER_LEVELS) && (diff >> WHEEL_SHIFT(lvl + 1)) != 0)
+		lvl++;
 
-void core_tsk_transfer( tsk_t *tsk, tsk_t **que )
-{
-	core_tsk_unlink(tsk, tsk->event);
-	core_tsk_append(tsk, que);
+	pos  = WHEEL_SLOT(time, lvl);
+	slot = &WHEEL.slot[lvl][pos];
+
+	if ((WHEEL.map[lvl][pos / 32] & (UINT32_C(1) << (pos % 32))) == 0)
+	{
+		slot->prev = slot->next = slot;
+		WHEEL.map[lvl][pos / 32] |= UINT32_C(1) << (pos % 32);
+		WHEEL.grp[lvl] |= UINT32_C(1) << (pos / 32);
+		WHEEL.lvl |= UINT32_C(1) << lvl;
+	}
+
+	priv_rdy_insert(&tmr->hdr, slot);
+
+	return true;
 }
 
 /* -------------------------------------------------------------------------- */
 
 static
-unsigned priv_tsk_wait( tsk_t *tsk, tsk_t **que, bool yield )
+void priv_whl_remove( hdr_t *hdr )
 {
-	assert_tsk_context();
-
-	core_tsk_append((tsk_t *)tsk, que);
-	priv_tsk_remove((tsk_t *)tsk);
-	core_tmr_insert((tmr_t *)tsk, ID_BLOCKED);
+	hdr_t  * prv = hdr->prev;
+	unsigned pos, lvl;
 
-	if (yield)
-		priv_ctx_switchNow();
+	priv_rdy_remove(hdr);
 
-	return tsk->event;
+	if (prv->next == prv && prv != &WAIT.hdr) // the slot became empty
+	{
+		pos = (unsigned)(prv - WHEEL.slot[0]);
+		lvl = pos / (OS_TIMER_WHEEL);
+		pos = pos % (OS_TIMER_WHEEL);
+		if ((WHEEL.map[lvl][pos / 32] &= ~(UINT32_C(1) << (pos % 32))) == 0)
+			if ((WHEEL.grp[lvl] &= ~(UINT32_C(1) << (pos / 32))) == 0)
+				WHEEL.lvl &= ~(UINT32_C(1) << lvl);
+	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-unsigned core_tsk_waitFor( tsk_t **que, cnt_t delay )
+static
+void priv_tmr_insert( tmr_t *tmr, tid_t id )
 {
-	tsk_t *cur = System.cur;
-
-	cur->start = core_sys_time();
-	cur->delay = delay;
+	tmr->hdr.id = id;
 
-	if (cur->delay == IMMEDIATE)
-		return E_TIMEOUT;
+	if (WHEEL.lvl == 0) // nothing to serve up to now
+		WHEEL.time = core_sys_time();
 
-	return priv_tsk_wait(cur, que, true);
+	if (!priv_whl_insert(tmr))
+		priv_tmr_sort(tmr);
 }
 
 /* -------------------------------------------------------------------------- */
 
-unsigned core_tsk_waitNext( tsk_t **que, cnt_t delay )
+static
+void priv_tmr_remove( tmr_t *tmr )
 {
-	tsk_t *cur = System.cur;
+	tmr->hdr.id = ID_STOPPED;
+	priv_whl_remove(&tmr->hdr);
+}
 
-	cur->delay = delay;
+/* -------------------------------------------------------------------------- */
 
-	if (cur->delay == IMMEDIATE)
-		return E_TIMEOUT;
+tmr_t *core_tmr_next( tmr_t *tmr )
+{
+	hdr_t  * nxt = tmr->hdr.next;
+	unsigned pos, lvl, idx;
+
+	if (nxt == &WAIT.hdr) // end of WAIT, continue with the first occupied slot
+		pos = 0;
+	else
+	if (nxt >= WHEEL.slot[0] && nxt <= &WHEEL.slot[(OS_TIMER_LEVELS)-1][(OS_TIMER_WHEEL)-1]) // end of the slot, continue with the next occupied one
+		pos = (unsigned)(nxt - WHEEL.slot[0]) + 1;
+	else
+		return (tmr_t *)nxt;
+
+	for (lvl = pos / (OS_TIMER_WHEEL), pos %= (OS_TIMER_WHEEL); lvl < (OS_TIMER_LEVELS); lvl++, pos = 0)
+	{
+		idx = priv_whl_find(lvl, pos);
+		if (idx < (OS_TIMER_WHEEL) && idx >= pos)
+			return WHEEL.slot[lvl][idx].next;
+	}
 
-	return priv_tsk_wait(cur, que, true);
+	return &WAIT;
 }
 
 /* -------------------------------------------------------------------------- */
+// check if the system time has reached the slot of level 'lvl' containing the deadline of timer 'tmr'
 
-unsigned core_tsk_waitUntil( tsk_t **que, cnt_t time )
+static inline
+bool priv_whl_reached( tmr_t *tmr, unsigned lvl )
 {
-	tsk_t *cur = System.cur;
-
-	cur->start = core_sys_time();
-	cur->delay = time - cur->start;
+	cnt_t rem = (cnt_t)(tmr->start + tmr->delay - WHEEL.time);
 
-	if (cur->delay > ((CNT_MAX)>>1))
-		return E_TIMEOUT;
+	if ((cnt_t)(rem - 1) >= ((CNT_MAX)>>1))
+	return true;  // return if timer has expired
 
-	return priv_tsk_wait(cur, que, true);
+	return rem <= (cnt_t)(WHEEL_MASK(lvl) - (WHEEL.time & WHEEL_MASK(lvl)));
 }
 
 /* -------------------------------------------------------------------------- */
+// insert expired timer 'tmr' into WAIT after the timers that expired earlier
 
-void core_tsk_suspend( tsk_t *tsk )
+static
+void priv_whl_move( tmr_t *tmr )
 {
-	tsk->delay = INFINITE;
+	tmr_t *nxt  = WAIT.hdr.next;
+	cnt_t  late = (cnt_t)(WHEEL.time - tmr->start - tmr->delay);
 
-	priv_tsk_wait(tsk, &System.dly, tsk == System.cur);
+	while (nxt->delay != INFINITE && nxt->delay <= (cnt_t)(WHEEL.time - nxt->start) && late <= (cnt_t)(WHEEL.time - nxt->start - nxt->delay))
+		nxt = nxt->hdr.next;
+
+	priv_rdy_insert(&tmr->hdr, &nxt->hdr);
 }
 
 /* -------------------------------------------------------------------------- */
+// serve the slots passed since the last service, starting from the highest level
 
-tsk_t *core_tsk_wakeup( tsk_t *tsk, unsigned event )
+static
+void priv_whl_collect( void )
 {
-	if (tsk)
+	cnt_t    old = WHEEL.time;
+	cnt_t    cnt;
+	unsigned lvl, pos, off, idx;
+	hdr_t  * slot;
+	tmr_t  * tmr;
+	tmr_t  * nxt;
+
+	WHEEL.time = core_sys_time();
+
+	for (lvl = OS_TIMER_LEVELS; lvl-- > 0; )
 	{
-		core_tsk_unlink((tsk_t *)tsk, event);
-		core_tmr_remove((tmr_t *)tsk);
-		core_tsk_insert((tsk_t *)tsk);
-	}
+		if ((WHEEL.lvl & (UINT32_C(1) << lvl)) == 0)
+			continue;
 
-	return tsk;
-}
+		cnt = (cnt_t)((WHEEL.time >> WHEEL_SHIFT(lvl)) - (old >> WHEEL_SHIFT(lvl))) & ((CNT_MAX) >> WHEEL_SHIFT(lvl));
+		if (cnt > (OS_TIMER_WHEEL))
+			cnt = (OS_TIMER_WHEEL);
 
-/* -------------------------------------------------------------------------- */
+		pos = (WHEEL_SLOT(old, lvl) + 1) % (OS_TIMER_WHEEL);
 
-void core_all_wakeup( tsk_t *tsk, unsigned event )
-{
-	while (tsk = core_tsk_wakeup(tsk, event), tsk) tsk = tsk->hdr.obj.queue;
+		for (off = 0; off < cnt; off = idx + 1)
+		{
+			idx = priv_whl_find(lvl, (pos + off) % (OS_TIMER_WHEEL));
+			if (idx == (OS_TIMER_WHEEL))
+				break;
+			idx = (idx + (OS_TIMER_WHEEL) - pos) % (OS_TIMER_WHEEL);
+			if (idx < off || idx >= cnt)
+				break;
+
+			slot = &WHEEL.slot[lvl][(pos + idx) % (OS_TIMER_WHEEL)];
+			for (tmr = slot->next; tmr != (tmr_t *)slot; tmr = nxt)
+			{
+				nxt = tmr->hdr.next;
+				if (priv_whl_reached(tmr, lvl))
+				{
+					priv_whl_remove(&tmr->hdr);
+					if (!priv_whl_insert(tmr))
+						priv_whl_move(tmr);
+				}
+			}
+		}
+	}
 }
 
 /* -------------------------------------------------------------------------- */
+// return the number of ticks from the time of the wheel to the nearest occupied slot; 0 if the wheel is empty
 
-unsigned core_tsk_count( tsk_t *tsk )
+static
+cnt_t priv_whl_delay( void )
 {
-	unsigned cnt = 0;
+	cnt_t    cnt = 0;
+	cnt_t    dly;
+	unsigned lvl, pos, idx;
 
-	while (tsk) { cnt++; tsk = tsk->hdr.obj.queue; }
+	for (lvl = 0; lvl < (OS_TIMER_LEVELS); lvl++)
+	{
+		if ((WHEEL.lvl & (UINT32_C(1) << lvl)) == 0)
+			continue;
+
+		pos = (WHEEL_SLOT(WHEEL.time, lvl) + 1) % (OS_TIMER_WHEEL);
+		idx = priv_whl_find(lvl, pos);
+		dly = (cnt_t)((cnt_t)((idx + (OS_TIMER_WHEEL) - pos) % (OS_TIMER_WHEEL) + 1) << WHEEL_SHIFT(lvl));
+		dly = (cnt_t)(dly - (WHEEL.time & WHEEL_MASK(lvl)));
+		if (cnt == 0 || cnt > dly)
+			cnt = dly;
+	}
 
 	return cnt;
 }
 
 /* -------------------------------------------------------------------------- */
 
+#if HW_TIMER_SIZE
+
+// start the hardware timer for the nearest occupied slot unless WAIT expires earlier
+
+static
+bool priv_whl_expired( void )
+{
+	tmr_t  * tmr = WAIT.hdr.next;
+	cnt_t    cnt = priv_whl_delay();
+
+	if (cnt == 0)
+	return false; // return if the wheel is empty
+
+	if (tmr->delay != INFINITE && (cnt_t)(tmr->start + priv_tmr_slack(tmr) - WHEEL.time) <= cnt)
+	return false; // return if the hardware timer has been started for WAIT
+
+	port_tmr_start((cnt_t)(WHEEL.time + cnt));
+
+	if (cnt > (cnt_t)(core_sys_time() - WHEEL.time))
+	return false; // return if the slot is still ahead
+
+	port_tmr_stop();
+
+	return true;  // however the slot has been reached
+}
+
+#else
+
+static inline
+bool priv_whl_expired( void )
+{
+	return false; // the wheel is served with every tick
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_TIMER_WHEEL
+
+/* -------------------------------------------------------------------------- */
+
+void core_tmr_insert( tmr_t *tmr, tid_t id )
+{
+	priv_tmr_insert(tmr, id);
+	port_tmr_force();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tmr_remove( tmr_t *tmr )
+{
+	priv_tmr_remove(tmr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if HW_TIMER_SIZE
+
+static
+bool priv_tmr_expired( tmr_t *tmr, bool merge )
+{
+	cnt_t delay = priv_tmr_slack(tmr);
+
+	port_tmr_stop();
+
+	if (delay == INFINITE)
+	return false; // return if timer counting indefinitely
+
+	if ((merge ? tmr->delay : delay) <= (cnt_t)(core_sys_time() - tmr->start))
+	return true;  // return if timer finished counting (in the current pass it is served without its slack)
+
+	port_tmr_start((cnt_t)(tmr->start + delay));
+
+	if (delay >  (cnt_t)(core_sys_time() - tmr->start))
+	return false; // return if timer still counts
+
+	port_tmr_stop();
+
+	return true;  // however timer finished counting
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else
+
+static
+bool priv_tmr_expired( tmr_t *tmr, bool merge )
+{
+	cnt_t delay = merge ? tmr->delay : priv_tmr_slack(tmr);
+
+	if (delay >= (cnt_t)(core_sys_time() - tmr->start + 1))
+	return false; // return if timer still counts or counting indefinitely
+
+	return true;  // timer finished counting
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TIMER_DAEMON
+
+// append the timer 'tmr' to the list of timers with pending callbacks and resume the timer daemon
+// the callback is executed by the daemon once for every expiration
+
+static
+void priv_tmr_defer( tmr_t *tmr )
+{
+	if (tmr->dmn.count++ == 0)
+	{
+		tmr->dmn.next = 0;
+		if (DAEMON.head)
+			DAEMON.tail->dmn.next = tmr;
+		else
+			DAEMON.head = tmr;
+		DAEMON.tail = tmr;
+
+		core_one_wakeup(DAEMON.queue, E_SUCCESS);
+	}
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tmr_wakeup( tmr_t *tmr, unsigned event )
+{
+	core_trc_event(TRC_TIMER, tmr, System.cur);
+
+#if OS_TIMER_DAEMON
+	if (tmr->dmn.on)
+	{
+		if (tmr->state)
+			priv_tmr_defer(tmr);
+	}
+	else
+#endif
+	if (tmr->state)
+		tmr->state();
+
+	core_tmr_remove(tmr);
+	if (tmr->delay != IMMEDIATE) // a late periodic timer is inserted as expired and catches up
+		priv_tmr_insert(tmr, ID_TIMER);
+
+	core_all_wakeup(tmr->hdr.obj.queue, event, port_get_lock());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tmr_handler( void )
+{
+	tmr_t *tmr;
+	bool   merge = false;
+
+	assert_stk_integrity();
+
+	port_set_lock();
+	{
+		do
+		{
+			priv_whl_collect();
+
+			while (priv_tmr_expired(tmr = WAIT.hdr.next, merge))
+			{
+#if OS_TIMER_SLACK
+				if (merge) MERGED++;
+#endif
+				merge = true;
+
+				tmr->start += tmr->delay;
+
+				if (tmr->hdr.id == ID_TIMER)
+				{
+					tmr->delay = tmr->period;
+
+					priv_tmr_wakeup((tmr_t *)tmr, E_SUCCESS);
+				}
+				else  /* hdr.id == ID_BLOCKED */
+					core_tsk_wakeup((tsk_t *)tmr, E_TIMEOUT);
+			}
+		}
+		while (priv_whl_expired());
+	}
+	port_clr_lock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+cnt_t core_tmr_delay( void )
+{
+	tmr_t *tmr = WAIT.hdr.next;
+	cnt_t  now = core_sys_time();
+	cnt_t  cnt = INFINITE;
+	cnt_t  dly;
+
+	if (tmr->delay != INFINITE)
+	{
+		dly = (cnt_t)(tmr->start + priv_tmr_slack(tmr) - now);
+		cnt = (cnt_t)(dly - 1) >= ((CNT_MAX)>>1) ? 0 : dly;
+	}
+
+#if OS_TIMER_WHEEL
+	dly = priv_whl_delay();
+	if (dly != 0)
+	{
+		dly = (cnt_t)(WHEEL.time + dly - now);
+		if ((cnt_t)(dly - 1) >= ((CNT_MAX)>>1))
+			dly = 0;
+		if (cnt > dly)
+			cnt = dly;
+	}
+#endif
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_TIME_NSEC
+
+// monotonic clock: 64-bit extension of the runtime counter published through a latch
+// the writer updates both copies in turn and the sequence counter points readers to the stable one,
+// so the reader never waits, even if it has preempted the writer in an interrupt handler
+// the refresh timer publishes the clock at least once per half of the period of the runtime counter
+
+#define CLK_PERIOD ((cnt_t)(((1ULL << 31) / (RUN_FREQUENCY)) * (OS_FREQUENCY)))
+
+#if     ((1ULL << 31) / (RUN_FREQUENCY)) == 0
+#error  OS_TIME_NSEC requires RUN_FREQUENCY < 2^31 Hz!
+#endif
+
+static void priv_clk_update( void );
+
+static struct
+{
+	tmr_t    tmr;   // refresh timer
+	volatile
+	unsigned seq;   // sequence counter; the copy to be read is 'seq & 1'
+	volatile
+	struct {
+	uint64_t cnt;   // extended value of the runtime counter
+	uint32_t run;   // value of the runtime counter at the update
+	}        val[2];
+}	CLOCK = { _TMR_INIT(priv_clk_update), 0, { { 0, 0 }, { 0, 0 } } };
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_clk_update( void )
+{
+	uint32_t run = core_run_time();
+	uint64_t cnt = CLOCK.val[0].cnt + (uint32_t)(run - CLOCK.val[0].run);
+
+	CLOCK.seq++;
+	port_set_barrier();
+	CLOCK.val[0].cnt = cnt;
+	CLOCK.val[0].run = run;
+	port_set_barrier();
+	CLOCK.seq++;
+	port_set_barrier();
+	CLOCK.val[1].cnt = cnt;
+	CLOCK.val[1].run = run;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_clk_start( void )
+{
+	sys_lock();
+	{
+		if (CLOCK.tmr.hdr.id == ID_STOPPED)
+		{
+			CLOCK.val[0].run = CLOCK.val[1].run = core_run_time();
+
+			CLOCK.tmr.start  = core_sys_time();
+			CLOCK.tmr.delay  = CLK_PERIOD;
+			CLOCK.tmr.period = CLK_PERIOD;
+#if OS_TIMER_SLACK
+			CLOCK.tmr.hdr.slack = CLK_PERIOD / 2;
+#endif
+			core_tmr_insert(&CLOCK.tmr, ID_TIMER);
+		}
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t core_clk_time( void )
+{
+	unsigned seq;
+	uint64_t cnt;
+	uint32_t run;
+
+	if (CLOCK.tmr.hdr.id == ID_STOPPED)
+		priv_clk_start();
+
+	do
+	{
+		seq = CLOCK.seq;
+		port_set_barrier();
+		cnt = CLOCK.val[seq & 1].cnt;
+		run = CLOCK.val[seq & 1].run;
+		run = core_run_time() - run;
+		port_set_barrier();
+	}
+	while (seq != CLOCK.seq);
+
+	return cnt + run;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// SYSTEM TASK SERVICES
+/* -------------------------------------------------------------------------- */
+
+#ifndef MAIN_TOP
+static  stk_t     MAIN_STK[STK_SIZE(OS_STACK_SIZE)];
+#define MAIN_TOP (MAIN_STK+STK_SIZE(OS_STACK_SIZE))
+#endif
+
+#if OS_CPU_COUNT > 1
+
+static  union  { stk_t STK[STK_SIZE(OS_IDLE_STACK)];
+        struct { char  stk[STK_OVER(OS_IDLE_STACK)-sizeof(ctx_t)]; ctx_t ctx; } CTX; }
+        IDLE_STACK[OS_CPU_COUNT] = { [0 ... (OS_CPU_COUNT)-1] = { .CTX = { .ctx = _CTX_INIT(core_tsk_loop) } } };
+#define IDLE_STK( cpu ) (void *)(&IDLE_STACK[cpu])
+#define IDLE_SP( cpu )  (void *)(&IDLE_STACK[cpu].CTX.ctx)
+
+static
+tsk_t IDLE_CPU[OS_CPU_COUNT];
+
+tsk_t MAIN = { .hdr={ .prev=&IDLE_CPU[0], .next=&IDLE_CPU[0], .id=ID_READY }, .stack=MAIN_TOP, .basic=OS_MAIN_PRIO, .prio=OS_MAIN_PRIO }; // main task
+static
+tsk_t IDLE_CPU[OS_CPU_COUNT] = { { .hdr={ .prev=&MAIN, .next=&MAIN, .id=ID_IDLE  }, .state=core_tsk_idle, .stack=IDLE_STK(0), .size=OS_IDLE_STACK, .sp=IDLE_SP(0) } }; // idle tasks and tasks queues
+sys_t System_CPU[OS_CPU_COUNT] = { { .cur=&MAIN, .idle=&IDLE_CPU[0] } };
+
+/* -------------------------------------------------------------------------- */
+// the other processors start with the empty tasks' queues
+// this constructor precedes all constructors of the application, where the tasks can be created
+
+__attribute__((constructor(101)))
+static
+void priv_cpu_init( void )
+{
+	unsigned cpu;
+
+	for (cpu = 1; cpu < OS_CPU_COUNT; cpu++)
+	{
+		IDLE_CPU[cpu] = (tsk_t){ .hdr={ .prev=&IDLE_CPU[cpu], .next=&IDLE_CPU[cpu], .id=ID_IDLE }, .state=core_tsk_idle, .stack=IDLE_STK(cpu), .size=OS_IDLE_STACK, .sp=IDLE_SP(cpu), .cpu=cpu };
+		System_CPU[cpu].cur  = &IDLE_CPU[cpu];
+		System_CPU[cpu].idle = &IDLE_CPU[cpu];
+	}
+}
+
+#define TSK_CPU( tsk )  ((tsk)->cpu)               // processor of the task 'tsk'
+#define TSK_IDLE( tsk ) IDLE_CPU[(tsk)->cpu]       // tasks' queue of the processor of the task 'tsk'
+#define TSK_CUR( tsk )  System_CPU[(tsk)->cpu].cur // current task of the processor of the task 'tsk'
+
+#else
+
+static  union  { stk_t STK[STK_SIZE(OS_IDLE_STACK)];
+        struct { char  stk[STK_OVER(OS_IDLE_STACK)-sizeof(ctx_t)]; ctx_t ctx; } CTX; }
+        IDLE_STACK = { .CTX = { .ctx = _CTX_INIT(core_tsk_loop) } };
+#define IDLE_STK (void *)(&IDLE_STACK)
+#define IDLE_SP  (void *)(&IDLE_STACK.CTX.ctx)
+
+tsk_t MAIN = { .hdr={ .prev=&IDLE, .next=&IDLE, .id=ID_READY }, .stack=MAIN_TOP, .basic=OS_MAIN_PRIO, .prio=OS_MAIN_PRIO }; // main task
+tsk_t IDLE = { .hdr={ .prev=&MAIN, .next=&MAIN, .id=ID_IDLE  }, .state=core_tsk_idle, .stack=IDLE_STK, .size=OS_IDLE_STACK, .sp=IDLE_SP }; // idle task and tasks queue
+sys_t System = { .cur=&MAIN };
+
+#define TSK_CPU( tsk )  ((void)(tsk), 0U)
+#define TSK_IDLE( tsk ) IDLE
+#define TSK_CUR( tsk )  System.cur
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// force context switch on the processor of the task 'tsk'
+
+static
+void priv_tsk_switch( tsk_t *tsk )
+{
+#if OS_CPU_COUNT > 1
+	port_cpu_switch(tsk->cpu);
+#else
+	(void) tsk;
+	port_ctx_switch();
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+// return true if both tasks belong to the EDF band and the deadline of task 'tsk' is earlier than the deadline of task 'nxt'
+
+static inline
+bool priv_edf_before( tsk_t *tsk, tsk_t *nxt )
+{
+#if OS_EDF_PRIO
+	return tsk->prio == (OS_EDF_PRIO) && nxt->prio == (OS_EDF_PRIO) &&
+	       (cnt_t)(nxt->deadline - tsk->deadline - 1) < ((CNT_MAX)>>1);
+#else
+	(void) tsk;
+	(void) nxt;
+	return false;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_PRIO_LEVELS == 0
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_insert( tsk_t *tsk )
+{
+	tsk_t *nxt = &TSK_IDLE(tsk);
+#if OS_ROBIN && HW_TIMER_SIZE == 0
+	tsk->slice = 0;
+#endif
+	if (tsk->prio)
+		do nxt = nxt->hdr.next;
+		while (tsk->prio < nxt->prio || (tsk->prio == nxt->prio && !priv_edf_before(tsk, nxt)));
+
+	priv_rdy_insert(&tsk->hdr, &nxt->hdr);
+}
+
+/* -------------------------------------------------------------------------- */
+// insert task 'tsk' into tasks' ready queue, searching from the task 'prv' inserted before
+// tasks of a blocked queue come in order of priority, so the whole queue is merged in one pass of the ready queue
+
+static
+void priv_tsk_merge( tsk_t *tsk, tsk_t *prv )
+{
+	tsk_t *nxt = &TSK_IDLE(tsk);
+#if OS_ROBIN && HW_TIMER_SIZE == 0
+	tsk->slice = 0;
+#endif
+	if (tsk->prio)
+	{
+		if (prv && TSK_CPU(prv) == TSK_CPU(tsk) && tsk->prio <= prv->prio && !priv_edf_before(tsk, prv))
+			nxt = prv;
+		do nxt = nxt->hdr.next;
+		while (tsk->prio < nxt->prio || (tsk->prio == nxt->prio && !priv_edf_before(tsk, nxt)));
+	}
+
+	priv_rdy_insert(&tsk->hdr, &nxt->hdr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_remove( tsk_t *tsk )
+{
+	priv_rdy_remove(&tsk->hdr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+// the current task keeps its position at the beginning of the new level
+// unless there is a task with higher priority; then it is moved to the end of the level
+// the current task is not always the first one in the queue (e.g. under the scheduler lock), so it is always re-inserted
+
+static
+void priv_cur_prio( tsk_t *cur, unsigned prio )
+{
+	tsk_t *nxt = &TSK_IDLE(cur);
+
+	if (cur->hdr.id != ID_READY)
+	{
+		cur->prio = prio;
+		return;
+	}
+
+	priv_tsk_remove(cur);
+	cur->prio = prio;
+
+	do nxt = nxt->hdr.next;
+	while (prio < nxt->prio || (prio == nxt->prio && priv_edf_before(nxt, cur)));
+
+	if (nxt != TSK_IDLE(cur).hdr.next)
+	{
+		while (nxt != &TSK_IDLE(cur) && prio == nxt->prio && !priv_edf_before(cur, nxt))
+			nxt = nxt->hdr.next;
+		priv_tsk_switch(cur);
+	}
+
+	priv_rdy_insert(&cur->hdr, &nxt->hdr);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else //OS_PRIO_LEVELS
+
+/* -------------------------------------------------------------------------- */
+// tasks' ready queue is still sorted by priority, but every occupied priority level is marked in the bitmap
+// and remembers its last task, so the insertion point is found without searching the queue
+// tasks with priority greater than or equal to OS_PRIO_LEVELS-1 share the highest level and are sorted within it
+
+#define PRIO_WORDS  (((OS_PRIO_LEVELS)+31)/32)
+#define PRIO_LEVEL( prio ) ((prio) < (OS_PRIO_LEVELS)-1 ? (prio) : (OS_PRIO_LEVELS)-1)
+#define MAIN_LEVEL  PRIO_LEVEL(OS_MAIN_PRIO)
+
+typedef struct
+{
+	uint32_t grp;                  // bitmap of non-empty words of the levels' bitmap
+	uint32_t map[PRIO_WORDS];      // bitmap of occupied priority levels
+	tsk_t  * tail[OS_PRIO_LEVELS]; // last task of each occupied priority level
+
+}	rdy_t;
+
+static rdy_t READY[OS_CPU_COUNT] = { { .grp=UINT32_C(1)<<(MAIN_LEVEL/32), .map={ [MAIN_LEVEL/32]=UINT32_C(1)<<(MAIN_LEVEL%32) }, .tail={ [MAIN_LEVEL]=&MAIN } } };
+
+/* -------------------------------------------------------------------------- */
+// return last task of the nearest occupied level higher than 'lvl' in the queue of the task 'tsk'; IDLE if there is no such level
+
+static
+tsk_t *priv_map_above( tsk_t *tsk, unsigned lvl )
+{
+	rdy_t  * rdy = &READY[TSK_CPU(tsk)];
+	unsigned idx = lvl / 32;
+	uint32_t map = rdy->map[idx] & (~UINT32_C(1) << (lvl % 32));
+
+	if (map == 0)
+	{
+		map = rdy->grp & (~UINT32_C(1) << idx);
+		if (map == 0)
+			return &TSK_IDLE(tsk);
+		idx = priv_map_first(map);
+		map = rdy->map[idx];
+	}
+
+	return rdy->tail[idx * 32 + priv_map_first(map)];
+}
+
+/* -------------------------------------------------------------------------- */
+// insert task 'tsk' into tasks' ready queue at the end ('head' == false) or at the beginning ('head' == true) of its level
+
+static
+void priv_map_insert( tsk_t *tsk, bool head )
+{
+	rdy_t  * rdy = &READY[TSK_CPU(tsk)];
+	unsigned lvl = PRIO_LEVEL(tsk->prio);
+	uint32_t bit = UINT32_C(1) << (lvl % 32);
+	bool     occ = rdy->map[lvl / 32] & bit;
+	tsk_t  * prv;
+
+	if (tsk->prio > lvl || (head && lvl == (OS_PRIO_LEVELS)-1)) // shared highest level
+	{
+		prv = &TSK_IDLE(tsk);
+		while (tsk->prio < ((tsk_t *)prv->hdr.next)->prio || (!head && tsk->prio == ((tsk_t *)prv->hdr.next)->prio))
+			prv = prv->hdr.next;
+	}
+#if OS_EDF_PRIO
+	else
+	if (occ && tsk->prio == (OS_EDF_PRIO)) // EDF band, ordered by deadlines
+	{
+		prv = priv_map_above(tsk, lvl);
+		while (prv != rdy->tail[lvl] && !priv_edf_before(tsk, prv->hdr.next))
+			prv = prv->hdr.next;
+	}
+#endif
+	else
+	if (occ && !head)
+		prv = rdy->tail[lvl];
+	else
+		prv = priv_map_above(tsk, lvl);
+
+	priv_rdy_insert(&tsk->hdr, prv->hdr.next);
+
+	if (!occ || prv == rdy->tail[lvl])
+		rdy->tail[lvl] = tsk;
+	rdy->map[lvl / 32] |= bit;
+	rdy->grp |= UINT32_C(1) << (lvl / 32);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_insert( tsk_t *tsk )
+{
+#if OS_ROBIN && HW_TIMER_SIZE == 0
+	tsk->slice = 0;
+#endif
+	if (tsk != &TSK_IDLE(tsk)) // idle task is the root of the queue
+		priv_map_insert(tsk, false);
+}
+
+/* -------------------------------------------------------------------------- */
+// the insertion point is found without searching the queue anyway
+
+static inline
+void priv_tsk_merge( tsk_t *tsk, tsk_t *prv )
+{
+	(void) prv;
+	priv_tsk_insert(tsk);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_remove( tsk_t *tsk )
+{
+	rdy_t  * rdy = &READY[TSK_CPU(tsk)];
+	unsigned lvl = PRIO_LEVEL(tsk->prio);
+	tsk_t  * prv = tsk->hdr.prev;
+
+	if (rdy->tail[lvl] == tsk)
+	{
+		if (prv != &TSK_IDLE(tsk) && PRIO_LEVEL(prv->prio) == lvl)
+			rdy->tail[lvl] = prv;
+		else
+		if ((rdy->map[lvl / 32] &= ~(UINT32_C(1) << (lvl % 32))) == 0)
+			rdy->grp &= ~(UINT32_C(1) << (lvl / 32));
+	}
+
+	priv_rdy_remove(&tsk->hdr);
+}
+
+/* -------------------------------------------------------------------------- */
+// the current task keeps its position at the beginning of the new level
+// unless there is a task with higher priority; then it is moved to the end of the level
+
+static
+void priv_cur_prio( tsk_t *cur, unsigned prio )
+{
+	if (cur->hdr.id != ID_READY)
+	{
+		cur->prio = prio;
+		return;
+	}
+
+	priv_tsk_remove(cur);
+	cur->prio = prio;
+	priv_map_insert(cur, true);
+
+	if (cur != TSK_IDLE(cur).hdr.next)
+	{
+		priv_tsk_remove(cur);
+		priv_map_insert(cur, false);
+		priv_tsk_switch(cur);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_PRIO_LEVELS
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_BASIC_STACK
+
+// shared stack of the basic tasks with the same priority (bound to the same processor)
+// basic tasks run to completion, so only one of them at a time has its frame on the stack
+
+typedef struct __bsk bsk_t;
+
+struct __bsk
+{
+	bsk_t  * next;  // next shared stack in the registry
+	tsk_t  * owner; // basic task that has its frame on the stack
+	unsigned prio;  // priority of the basic tasks
+	unsigned cpu;   // processor of the basic tasks
+};
+
+static
+bsk_t *BSK = 0; // registry of shared stacks
+
+#define BSK_BASE( bsk ) (stk_t *)((size_t)(bsk) + SEG_OVER(sizeof(bsk_t)))
+#define BSK_CTX( bsk )  ((ctx_t *)STK_CROP(BSK_BASE(bsk), OS_BASIC_STACK) - 1)
+
+/* -------------------------------------------------------------------------- */
+// return shared stack for the basic tasks with priority 'prio' bound to the processor 'cpu'
+// the stack is allocated when the first of these tasks is started; return 0 if there is no memory for it
+
+static
+bsk_t *priv_bsk_get( unsigned prio, unsigned cpu )
+{
+	bsk_t *bsk;
+
+	for (bsk = BSK; bsk; bsk = bsk->next)
+		if (bsk->prio == prio && bsk->cpu == cpu)
+			return bsk;
+
+	bsk = sys_alloc(SEG_OVER(sizeof(bsk_t)) + OS_BASIC_STACK);
+	if (bsk == 0)
+		return 0;
+
+	bsk->prio = prio;
+	bsk->cpu  = cpu;
+	bsk->next = BSK;
+	BSK = bsk;
+
+	port_ctx_init(BSK_CTX(bsk), core_tsk_loop);
+
+	return bsk;
+}
+
+/* -------------------------------------------------------------------------- */
+// return true if the basic task 'tsk' is in the middle of its state function
+
+static inline
+bool priv_bsc_busy( tsk_t *tsk )
+{
+	return tsk->bsc.stk && tsk->sp;
+}
+
+/* -------------------------------------------------------------------------- */
+// drop the frame of the basic task 'tsk' from the shared stack
+
+static
+void priv_bsc_drop( tsk_t *tsk )
+{
+	if (tsk->bsc.stk->owner == tsk)
+		tsk->bsc.stk->owner = 0;
+	tsk->sp = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+// the basic task 'tsk' has been switched out; drop its frame if it has finished the state function or has been blocked
+
+static inline
+void priv_bsc_leave( tsk_t *tsk )
+{
+	if (tsk->bsc.stk && (tsk->bsc.done || tsk->hdr.id != ID_READY))
+		priv_bsc_drop(tsk);
+}
+
+/* -------------------------------------------------------------------------- */
+// the basic task 'tsk' is going to run; create its context on the shared stack if it starts the state function
+
+static inline
+void priv_bsc_enter( tsk_t *tsk )
+{
+	if (tsk->bsc.stk && tsk->sp == 0)
+	{
+		assert(tsk->bsc.stk->owner == 0);
+		tsk->bsc.stk->owner = tsk;
+		tsk->bsc.done = false;
+		tsk->sp = BSK_CTX(tsk->bsc.stk);
+		port_ctx_init(tsk->sp, core_tsk_loop);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+#else
+
+#define priv_bsc_busy( tsk ) ((void)(tsk), false)
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_insert( tsk_t *tsk )
+{
+	tsk->hdr.id = ID_READY;
+	priv_tsk_insert(tsk);
+	if (tsk == TSK_IDLE(tsk).hdr.next)
+		priv_tsk_switch(tsk);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_remove( tsk_t *tsk )
+{
+	tsk->hdr.id = ID_STOPPED;
+	priv_tsk_remove(tsk);
+#if OS_BASIC_STACK
+	if (tsk->bsc.stk)
+		priv_bsc_drop(tsk);
+#endif
+	if (tsk == System.cur)
+		priv_ctx_switchNow();
+#if OS_CPU_COUNT > 1
+	else
+	if (tsk == TSK_CUR(tsk)) // task is running on another processor
+		priv_tsk_switch(tsk);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool core_ctx_init( tsk_t *tsk )
+{
+#if OS_BASIC_STACK
+	if (tsk->stack == 0 || tsk->bsc.stk) // basic task
+	{
+		if (tsk->bsc.stk)
+			priv_bsc_drop(tsk);
+		tsk->bsc.stk = priv_bsk_get(tsk->basic, TSK_CPU(tsk));
+		tsk->sp    = 0; // context is created when the task is scheduled
+		if (tsk->bsc.stk == 0)
+		{
+			tsk->stack = 0;
+			return false;
+		}
+		tsk->stack = BSK_BASE(tsk->bsc.stk);
+		tsk->size  = OS_BASIC_STACK;
+		return true;
+	}
+#endif
+#ifdef DEBUG
+	memset(tsk->stack, 0xFF, tsk->size);
+#endif
+	tsk->sp = (ctx_t *)STK_CROP(tsk->stack, tsk->size) - 1;
+	port_ctx_init(tsk->sp, core_tsk_loop);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_ctx_switch( void )
+{
+	tsk_t *cur = IDLE.hdr.next;
+	tsk_t *nxt = cur->hdr.next;
+	if (nxt->prio == cur->prio)
+		port_ctx_switch();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_sch_unlock( void )
+{
+	assert(System.hold);
+
+	if (--System.hold == 0 && System.skip)
+	{
+		System.skip = false;
+		port_ctx_switch();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_ISR_LOCKFREE
+
+static
+void * volatile PENDING = 0; // lock-free list of the objects with pending posts of the interrupt handlers (LIFO order)
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_pnd_push( pnd_t *pnd, pnd_fun *fun )
+{
+	void *que;
+
+	pnd->fun = fun;
+
+	do pnd->next = que = PENDING;
+	while (!port_atm_cas(&PENDING, que, pnd));
+
+	port_ctx_switch();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_pnd_add( pnd_t *pnd, pnd_fun *fun, unsigned val )
+{
+	if (port_atm_add(&pnd->pend, val) == 0)
+		priv_pnd_push(pnd, fun);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_pnd_set( pnd_t *pnd, pnd_fun *fun, unsigned val )
+{
+	if (port_atm_or(&pnd->pend, val) == 0)
+		priv_pnd_push(pnd, fun);
+}
+
+/* -------------------------------------------------------------------------- */
+
+// the object may be posted again as soon as its pending word is cleared, so its link is read before
+
+void core_pnd_flush( void )
+{
+	pnd_t *pnd;
+	pnd_t *nxt;
+	pnd_t *lst = 0;
+
+	do pnd = PENDING;
+	while (pnd && !port_atm_cas(&PENDING, pnd, 0));
+
+	for (; pnd; pnd = nxt) // restore the order of the posts
+	{
+		nxt = pnd->next;
+		pnd->next = lst;
+		lst = pnd;
+	}
+
+	for (pnd = lst; pnd; pnd = nxt)
+	{
+		nxt = pnd->next;
+		pnd->fun(pnd, port_atm_swap(&pnd->pend, 0));
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
+
+#if OS_BASIC_STACK
+static bool priv_bsc_chain( void );
+#endif
+
+void core_tsk_loop( void )
+{
+	for (;;)
+	{
+		port_clr_lock();
+#if OS_BASIC_STACK
+		System.cur->bsc.done = false;
+#endif
+		System.cur->state();
+		port_set_lock();
+#if OS_BASIC_STACK
+		System.cur->bsc.done = true;
+		if (priv_bsc_chain())
+			continue;
+#endif
+		core_ctx_switch();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+// count the change of the blocked queues, seen by the kernel loops after the interrupt window
+
+static inline
+void priv_que_change( void )
+{
+#if OS_LOCK_SPAN
+	System.seq++;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_append( tsk_t *tsk, tsk_t **que )
+{
+	tsk_t *nxt = *que;
+	tsk->guard = que;
+
+	priv_que_change();
+
+	while (nxt && tsk->prio <= nxt->prio)
+	{
+		que = &nxt->hdr.obj.queue;
+		nxt = *que;
+	}
+
+	if (nxt)
+		nxt->back = &tsk->hdr.obj.queue;
+	tsk->back = que;
+	tsk->hdr.obj.queue = nxt;
+	*que = tsk;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void priv_tsk_unlink( tsk_t *tsk )
+{
+	tsk_t**que = tsk->back;
+	tsk_t *nxt = tsk->hdr.obj.queue;
+
+	priv_que_change();
+
+	if (nxt)
+		nxt->back = que;
+	*que = nxt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_unlink( tsk_t *tsk, unsigned event )
+{
+	mtx_t *mtx = tsk->mtx.tree;
+
+	tsk->event = event;
+	tsk->guard = 0;
+
+	priv_tsk_unlink(tsk);
+
+	if (mtx)
+	{
+		tsk->mtx.tree = 0;
+		core_mtx_update(mtx, 0);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_transfer( tsk_t *tsk, tsk_t **que )
+{
+	priv_tsk_unlink(tsk);
+	core_tsk_append(tsk, que);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned priv_tsk_wait( tsk_t *tsk, tsk_t **que, bool yield )
+{
+	assert_tsk_context();
+	assert(!yield || System.hold == 0); // the current task must not block with the scheduler locked
+
+	core_trc_event(TRC_BLOCK, que, tsk);
+
+	core_tsk_append((tsk_t *)tsk, que);
+	priv_tsk_remove((tsk_t *)tsk);
+	core_tmr_insert((tmr_t *)tsk, ID_BLOCKED);
+
+	if (yield)
+		priv_ctx_switchNow();
+#if OS_CPU_COUNT > 1
+	else
+	if (tsk == TSK_CUR(tsk)) // task is running on another processor
+		priv_tsk_switch(tsk);
+#endif
+
+	return tsk->event;
+}
+
+/* -------------------------------------------------------------------------- */
+
+unsigned core_tsk_waitFor( tsk_t **que, cnt_t delay )
+{
+	tsk_t *cur = System.cur;
+
+	cur->start = core_sys_time();
+	cur->delay = delay;
+
+	if (cur->delay == IMMEDIATE)
+		return E_TIMEOUT;
+
+	return priv_tsk_wait(cur, que, true);
+}
+
+/* -------------------------------------------------------------------------- */
+
+unsigned core_tsk_waitNext( tsk_t **que, cnt_t delay )
+{
+	tsk_t *cur = System.cur;
+
+	cur->delay = delay;
+
+	if (cur->delay == IMMEDIATE)
+		return E_TIMEOUT;
+
+	return priv_tsk_wait(cur, que, true);
+}
+
+/* -------------------------------------------------------------------------- */
+
+unsigned core_tsk_waitUntil( tsk_t **que, cnt_t time )
+{
+	tsk_t *cur = System.cur;
+
+	cur->start = core_sys_time();
+	cur->delay = time - cur->start;
+
+	if (cur->delay > ((CNT_MAX)>>1))
+		return E_TIMEOUT;
+
+	return priv_tsk_wait(cur, que, true);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_tsk_suspend( tsk_t *tsk )
+{
+	tsk->delay = INFINITE;
+
+	priv_tsk_wait(tsk, &System.dly, tsk == System.cur);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_prx_wait( tsk_t *prx, tsk_t **que, cnt_t delay )
+{
+	assert(core_tsk_proxy(prx));
+
+	prx->start = core_sys_time();
+	prx->delay = delay;
+
+	core_trc_event(TRC_BLOCK, que, prx);
+
+	core_tsk_append(prx, que);
+	core_tmr_insert((tmr_t *)prx, ID_BLOCKED);
+}
+
+/* -------------------------------------------------------------------------- */
+// the proxy 'prx' has been resumed; pass it to its procedure instead of scheduling it
+
+static inline
+void priv_prx_resume( tsk_t *prx )
+{
+	prx->hdr.id = ID_STOPPED;
+	((prx_t *)prx->state)(prx);
+}
+
+/* -------------------------------------------------------------------------- */
+
+tsk_t *core_tsk_wakeup( tsk_t *tsk, unsigned event )
+{
+	if (tsk)
+	{
+		core_trc_event(TRC_WAKEUP, tsk->guard, tsk);
+
+		core_tsk_unlink((tsk_t *)tsk, event);
+		core_tmr_remove((tmr_t *)tsk);
+		if (core_tsk_proxy(tsk))
+			priv_prx_resume(tsk);
+		else
+			core_tsk_insert((tsk_t *)tsk);
+	}
+
+	return tsk;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// the whole blocked queue is detached from the guard object at once and merged into the ready queue in one pass
+// context switch is forced at most once for every processor
+// in the window of the kernel loop the rest of the queue is attached back to the guard object,
+// because the interrupt handlers may remove the tasks from it or change their priorities
+
+void core_all_wakeup( tsk_t *tsk, unsigned event, lck_t lck )
+{
+	tsk_t ** que;
+	tsk_t  * prv = 0;
+	tsk_t  * nxt;
+	mtx_t  * mtx = 0;
+	hld_t    hld;
+#if OS_CPU_COUNT > 1
+	uint32_t map = 0;
+	unsigned cpu;
+#else
+	bool     map = false;
+#endif
+
+	if (tsk == 0)
+		return;
+
+	que = tsk->back;
+	*que = 0;
+
+	priv_que_change();
+
+	core_hld_init(&hld, LCK_WAKEUP, lck);
+
+	while (tsk)
+	{
+		core_trc_event(TRC_WAKEUP, tsk->guard, tsk);
+
+		tsk->event = event;
+		tsk->guard = 0;
+		if (tsk->mtx.tree)
+		{
+			mtx = tsk->mtx.tree;
+			tsk->mtx.tree = 0;
+		}
+
+		core_tmr_remove((tmr_t *)tsk);
+
+		if (core_tsk_proxy(tsk))
+		{
+			nxt = tsk->hdr.obj.queue; // the proxy can be reused as soon as it is resumed
+			priv_prx_resume(tsk);
+			tsk = nxt;
+		}
+		else
+		{
+			tsk->hdr.id = ID_READY;
+			priv_tsk_merge(tsk, prv);
+
+			if (tsk == TSK_IDLE(tsk).hdr.next)
+#if OS_CPU_COUNT > 1
+				map |= UINT32_C(1) << TSK_CPU(tsk);
+#else
+				map = true;
+#endif
+
+			prv = tsk;
+			tsk = tsk->hdr.obj.queue;
+		}
+
+		if (tsk && core_hld_tick(&hld))
+		{
+			if (mtx)
+				core_mtx_update(mtx, 0);
+			mtx = 0;
+			if (map)
+				port_ctx_switch();
+			map = 0;
+
+			tsk->back = que;
+			*que = tsk;
+			core_hld_window(&hld);
+			tsk = *que;
+			*que = 0;
+			prv = 0;
+		}
+	}
+
+	if (mtx)
+		core_mtx_update(mtx, 0);
+
+#if OS_CPU_COUNT > 1
+	for (cpu = 0; map; cpu++, map >>= 1)
+		if (map & 1)
+			port_cpu_switch(cpu);
+#else
+	if (map)
+		port_ctx_switch();
+#endif
+
+	core_hld_done(&hld);
+}
+
+/* -------------------------------------------------------------------------- */
+
+unsigned core_tsk_count( tsk_t *tsk )
+{
+	unsigned cnt = 0;
+
+	while (tsk) { cnt++; tsk = tsk->hdr.obj.queue; }
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// return the basic priority of the task, lowered to the background priority of its budget reservation if the budget has been exhausted
+
+static inline
+unsigned priv_tsk_basic( tsk_t *tsk )
+{
+#if OS_BUDGET
+	bgt_t *bgt = tsk->bgt.owner;
+
+	if (bgt && bgt->left == 0 && bgt->prio < tsk->basic)
+		return bgt->prio;
+#endif
+	return tsk->basic;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void core_tsk_prio( tsk_t *tsk, unsigned prio )
 {
-	mtx_t *mtx;
-
-	if (prio < tsk->basic)
-		prio = tsk->basic;
+	if (prio < priv_tsk_basic(tsk))
+		prio = priv_tsk_basic(tsk);
 
-	for (mtx = tsk->mtx.list; mtx; mtx = mtx->list)
-		if ((mtx->mode & mtxPrioMASK) != mtxPrioNone && mtx->obj.queue)
-			if (prio < mtx->obj.queue->prio)
-				prio = mtx->obj.queue->prio;
+	if (prio < tsk->mtx.prio)
+		prio = tsk->mtx.prio;
 
 	if (tsk->prio != prio)
 	{
-		tsk->prio = prio;
-
-		if (tsk == System.cur)
-		{
-			tsk = tsk->hdr.next;
-			if (tsk->prio > prio)
-				port_ctx_switch();
-		}
+		if (tsk == TSK_CUR(tsk))
+			priv_cur_prio(tsk, prio);
 		else
 		if (tsk->hdr.id == ID_READY)
 		{
 			priv_tsk_remove(tsk);
+			tsk->prio = prio;
 			core_tsk_insert(tsk);
 		}
 		else
-		if (tsk->hdr.id == ID_BLOCKED)
 		{
-			core_tsk_transfer(tsk, tsk->guard);
-			if (tsk->mtx.tree)
-				core_tsk_prio(tsk->mtx.tree->owner, prio);
+			tsk->prio = prio;
+
+			if (tsk->hdr.id == ID_BLOCKED)
+			{
+				core_tsk_transfer(tsk, tsk->guard);
+				if (tsk->mtx.tree)
+					core_mtx_update(tsk->mtx.tree, 0);
+			}
 		}
 	}
 }
@@ -483,26 +1795,63 @@ void core_tsk_prio( tsk_t *tsk, unsigned prio )
 
 void core_cur_prio( unsigned prio )
 {
-	mtx_t *mtx;
 	tsk_t *tsk = System.cur;
 
-	if (prio < tsk->basic)
-		prio = tsk->basic;
+	if (prio < priv_tsk_basic(tsk))
+		prio = priv_tsk_basic(tsk);
 
-	for (mtx = tsk->mtx.list; mtx; mtx = mtx->list)
-		if ((mtx->mode & mtxPrioMASK) != mtxPrioNone && mtx->obj.queue)
-			if (prio < mtx->obj.queue->prio)
-				prio = mtx->obj.queue->prio;
+	if (prio < tsk->mtx.prio)
+		prio = tsk->mtx.prio;
 
 	if (tsk->prio != prio)
+		priv_cur_prio(tsk, prio);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_EDF_PRIO
+
+void core_cur_deadline( cnt_t deadline )
+{
+	tsk_t *cur = System.cur;
+
+	cur->deadline = deadline;
+
+	if (cur->prio == (OS_EDF_PRIO) && cur->hdr.id == ID_READY)
 	{
-		tsk->prio = prio;
-		tsk = tsk->hdr.next;
-		if (tsk->prio > prio)
-			port_ctx_switch();
+		priv_tsk_remove(cur);
+		priv_tsk_insert(cur);
+		if (cur != IDLE.hdr.next)
+			priv_tsk_switch(cur);
 	}
 }
 
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_ROBIN
+
+// return the length of the time slice of the task 'tsk' (in ticks)
+
+static inline
+cnt_t priv_tsk_quantum( tsk_t *tsk )
+{
+	return tsk->quantum ? tsk->quantum : (OS_FREQUENCY)/(OS_ROBIN);
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// return true if the task 'tsk' holds a stack resource policy mutex
+// the task keeps the processor; tasks with the same priority (at the ceiling) are not dispatched
+
+static inline
+bool priv_tsk_ceiling( tsk_t *tsk )
+{
+	return tsk->mtx.srp != 0;
+}
+
 /* -------------------------------------------------------------------------- */
 
 void *core_tsk_handler( void *sp )
@@ -513,17 +1862,34 @@ void *core_tsk_handler( void *sp )
 
 	port_set_lock();
 	{
+#if OS_ISR_LOCKFREE
+		core_pnd_flush(); // the context switch requested by the resolved posts is already handled
+#endif
 		core_ctx_reset();
 
 		cur = System.cur;
 		cur->sp = sp;
 
+#if OS_BASIC_STACK
+		priv_bsc_leave(cur);
+#endif
+
+#if OS_TASK_RUNTIME
+		core_run_account();
+#endif
+
 		nxt = IDLE.hdr.next;
 
+		if (System.hold && cur->hdr.id == ID_READY) // task switching is deferred by the scheduler lock
+		{
+			System.skip = true;
+			nxt = cur;
+		}
+		else
 #if OS_ROBIN && HW_TIMER_SIZE == 0
-		if (cur == nxt || (nxt->slice >= (OS_FREQUENCY)/(OS_ROBIN) && (nxt->slice = 0) == 0))
+		if ((cur == nxt || (nxt->slice >= priv_tsk_quantum(nxt) && (nxt->slice = 0) == 0)) && !priv_bsc_busy(nxt) && !priv_tsk_ceiling(nxt))
 #else
-		if (cur == nxt)
+		if (cur == nxt && !priv_bsc_busy(nxt) && !priv_tsk_ceiling(nxt))
 #endif
 		{
 			priv_tsk_remove(nxt);
@@ -531,18 +1897,144 @@ void *core_tsk_handler( void *sp )
 			nxt = IDLE.hdr.next;
 		}
 
+		if (cur != nxt)
+			core_trc_event(TRC_SWITCH, cur, nxt);
+
+#if OS_BASIC_STACK
+		priv_bsc_enter(nxt);
+#endif
+
 		System.cur = nxt;
 		sp = nxt->sp;
+
+#if OS_ROBIN && HW_TIMER_SIZE && defined(port_ctx_slice)
+		port_ctx_slice(priv_tsk_quantum(nxt));
+#endif
 	}
 	port_clr_lock();
 
 	return sp;
 }
 
+/* -------------------------------------------------------------------------- */
+
+#if OS_BASIC_STACK
+
+// the basic task has finished its state function; if the next task to run is a basic task starting its state function
+// on the same shared stack, it takes over the current frame in place (run to completion without the context switch)
+// the scheduler state is changed the same way as in core_tsk_handler
+
+static
+bool priv_bsc_chain( void )
+{
+	tsk_t *cur = System.cur;
+	tsk_t *nxt = cur->hdr.next;
+
+	if (cur->bsc.stk == 0 || cur != IDLE.hdr.next || nxt->prio != cur->prio)
+		return false;
+	if (nxt->bsc.stk != cur->bsc.stk || priv_bsc_busy(nxt) || System.hold || priv_tsk_ceiling(cur))
+		return false;
+
+	priv_tsk_remove(cur);
+	priv_tsk_insert(cur);
+	priv_bsc_drop(cur);
+	assert(IDLE.hdr.next == nxt);
+
+#if OS_TASK_RUNTIME
+	core_run_account();
+#endif
+
+	core_trc_event(TRC_SWITCH, cur, nxt);
+
+	nxt->bsc.stk->owner = nxt;
+	nxt->bsc.done = false;
+	nxt->sp = BSK_CTX(nxt->bsc.stk);
+
+	System.cur = nxt;
+
+#if OS_ROBIN && HW_TIMER_SIZE && defined(port_ctx_slice)
+	port_ctx_slice(priv_tsk_quantum(nxt));
+#endif
+
+	return true;
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 // SYSTEM MUTEX SERVICES
 /* -------------------------------------------------------------------------- */
 
+// return the priority inherited by the owner from the mutex 'mtx'
+
+static
+unsigned priv_mtx_boost( mtx_t *mtx )
+{
+	unsigned prio = 0;
+
+	if ((mtx->mode & mtxPrioMASK) == mtxPrioSRP)
+		prio = mtx->prio;
+	if ((mtx->mode & mtxPrioMASK) != mtxPrioNone && mtx->obj.queue)
+		if (prio < mtx->obj.queue->prio)
+			prio = mtx->obj.queue->prio;
+
+	return prio;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// insert the mutex 'mtx' into the list of mutexes held by the task 'tsk', ordered by the inherited priority
+// skip only the mutexes passing a higher priority; usually none of the mutexes held is contended
+
+static
+void priv_mtx_link( mtx_t *mtx, tsk_t *tsk )
+{
+	mtx_t**que = &tsk->mtx.list;
+	mtx_t *nxt = *que;
+
+	while (nxt && nxt->boost > mtx->boost)
+	{
+		que = &nxt->list;
+		nxt = *que;
+	}
+
+	if (nxt)
+		nxt->back = &mtx->list;
+	mtx->back = que;
+	mtx->list = nxt;
+	*que = mtx;
+
+	if ((mtx->mode & mtxPrioMASK) == mtxPrioSRP)
+		tsk->mtx.srp++;
+
+	tsk->mtx.prio = tsk->mtx.list->boost;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// remove the mutex 'mtx' from the list of mutexes held by the task 'tsk'
+
+static
+void priv_mtx_unlink( mtx_t *mtx, tsk_t *tsk )
+{
+	mtx_t**que = mtx->back;
+	mtx_t *nxt = mtx->list;
+
+	if (nxt)
+		nxt->back = que;
+	*que = nxt;
+
+	mtx->list = 0;
+	mtx->back = 0;
+
+	if ((mtx->mode & mtxPrioMASK) == mtxPrioSRP)
+		tsk->mtx.srp--;
+
+	tsk->mtx.prio = tsk->mtx.list ? tsk->mtx.list->boost : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void core_mtx_link( mtx_t *mtx, tsk_t *tsk )
 {
 	assert(mtx);
@@ -551,8 +2043,11 @@ void core_mtx_link( mtx_t *mtx, tsk_t *tsk )
 
 	if (tsk)
 	{
-		mtx->list = tsk->mtx.list;
-		tsk->mtx.list = mtx;
+		mtx->boost = priv_mtx_boost(mtx);
+		priv_mtx_link(mtx, tsk);
+
+		if (tsk->prio < mtx->boost)
+			core_tsk_prio(tsk, 0); // inherited priority or immediate priority ceiling
 	}
 }
 
@@ -561,7 +2056,6 @@ void core_mtx_link( mtx_t *mtx, tsk_t *tsk )
 void core_mtx_unlink( mtx_t *mtx )
 {
 	tsk_t *tsk;
-	mtx_t *lst;
 
 	assert(mtx);
 
@@ -569,18 +2063,32 @@ void core_mtx_unlink( mtx_t *mtx )
 
 	if (tsk)
 	{
-		if (tsk->mtx.list == mtx)
-			tsk->mtx.list = mtx->list;
+		priv_mtx_unlink(mtx, tsk);
 
-		for (lst = tsk->mtx.list; lst; lst = lst->list)
-			if (lst->list == mtx)
-				lst->list = mtx->list;
-
-		mtx->list  = 0;
 		mtx->owner = 0;
 		mtx->count = 0;
 
-		core_tsk_prio(tsk, tsk->basic);
+		core_tsk_prio(tsk, 0);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_mtx_update( mtx_t *mtx, unsigned prio )
+{
+	tsk_t *tsk = mtx->owner;
+	unsigned boost = priv_mtx_boost(mtx);
+
+	if ((mtx->mode & mtxPrioMASK) != mtxPrioNone && boost < prio)
+		boost = prio;
+
+	if (tsk && mtx->boost != boost)
+	{
+		priv_mtx_unlink(mtx, tsk);
+		mtx->boost = boost;
+		priv_mtx_link(mtx, tsk);
+
+		core_tsk_prio(tsk, 0);
 	}
 }
 
@@ -597,29 +2105,247 @@ tsk_t *core_mtx_transferLock( mtx_t *mtx, unsigned event )
 	return tsk;
 }
 
+/* -------------------------------------------------------------------------- */
+// SYSTEM BUDGET SERVICES
+/* -------------------------------------------------------------------------- */
+
+#if OS_BUDGET
+
+void core_bgt_update( bgt_t *bgt )
+{
+	tsk_t *tsk;
+
+	for (tsk = bgt->list; tsk; tsk = tsk->bgt.next)
+		core_tsk_prio(tsk, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_bgt_handler( void )
+{
+	bgt_t *bgt = (bgt_t *) WAIT.hdr.next; // the expired replenishment timer is the first one in the timers queue
+	cnt_t left = bgt->left;
+
+	bgt->left = bgt->budget;
+
+	if (left == 0)
+		core_bgt_update(bgt);
+}
+
+/* -------------------------------------------------------------------------- */
+
+// charge the budget reservation of the task 'tsk' with one tick of the system timer
+
+static
+void priv_bgt_charge( tsk_t *tsk )
+{
+	bgt_t *bgt = tsk->bgt.owner;
+
+	if (bgt && bgt->tmr.hdr.id == ID_TIMER && bgt->left && --bgt->left == 0)
+		core_bgt_update(bgt);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 // OTHER SYSTEM SERVICES
 /* -------------------------------------------------------------------------- */
 
+#if OS_TASK_RUNTIME
+
+static
+void priv_run_account( sys_t *sys )
+{
+	uint32_t now = core_run_time();
+	uint32_t run = now - sys->rtm;
+
+	sys->cur->runtime += run;
+	sys->run += run;
+	sys->rtm = now;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_run_account( void )
+{
+	priv_run_account(&System);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
+
+#if OS_LOCK_STATS
+
+static
+uint32_t HOLD[LCK_COUNT]; // the longest lock hold of every bounded kernel loop
+
+/* -------------------------------------------------------------------------- */
+
+void core_hld_done( hld_t *hld )
+{
+	uint32_t run = core_run_time() - hld->run;
+
+	if (HOLD[hld->fun] < run)
+		HOLD[hld->fun] = run;
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint32_t core_hld_max( unsigned fun )
+{
+	uint32_t run = HOLD[fun];
+
+	HOLD[fun] = 0;
+
+	return run;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
+
+#if OS_LOCK_SPAN
+
+// the scheduler is locked for the time of the window; the task switch requested in it is forced after the window
+
+bool core_hld_window( hld_t *hld )
+{
+	unsigned seq = System.seq;
+
+	core_hld_done(hld);
+
+	core_sch_lock();
+	port_put_lock(hld->lck); port_set_barrier();
+	port_set_lock();
+	core_sch_unlock();
+
+#if OS_LOCK_STATS
+	hld->run = core_run_time();
+#endif
+	return seq != System.seq;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif
+
 #if HW_TIMER_SIZE == 0
 
+#if OS_CPU_COUNT > 1
+
+// the system timer is served by the first processor, which also counts time slices of all processors
+
+void core_sys_tick( void )
+{
+	#if OS_ROBIN || OS_TASK_RUNTIME || OS_BUDGET
+	unsigned cpu;
+	#endif
+
+	System_CPU[0].cnt++;
+	core_tmr_handler();
+	#if OS_BUDGET
+	port_set_lock();
+	for (cpu = 0; cpu < OS_CPU_COUNT; cpu++)
+		priv_bgt_charge(System_CPU[cpu].cur);
+	port_clr_lock();
+	#endif
+	#if OS_TASK_RUNTIME
+	port_set_lock();
+	for (cpu = 0; cpu < OS_CPU_COUNT; cpu++)
+		priv_run_account(&System_CPU[cpu]);
+	port_clr_lock();
+	#endif
+	#if OS_ROBIN
+	port_set_lock();
+	for (cpu = 0; cpu < OS_CPU_COUNT; cpu++)
+	{
+		tsk_t *cur = IDLE_CPU[cpu].hdr.next;
+		tsk_t *nxt = cur->hdr.next;
+		if (++System_CPU[cpu].cur->slice >= priv_tsk_quantum(System_CPU[cpu].cur) && nxt->prio == cur->prio)
+			port_cpu_switch(cpu);
+	}
+	port_clr_lock();
+	#endif
+}
+
+#else
+
 void core_sys_tick( void )
 {
 	System.cnt++;
 	core_tmr_handler();
+	#if OS_BUDGET
+	port_set_lock();
+	priv_bgt_charge(System.cur);
+	port_clr_lock();
+	#endif
+	#if OS_TASK_RUNTIME
+	port_set_lock();
+	core_run_account();
+	port_clr_lock();
+	#endif
 	#if OS_ROBIN
-	if (++System.cur->slice >= (OS_FREQUENCY)/(OS_ROBIN))
+	if (++System.cur->slice >= priv_tsk_quantum(System.cur))
 		core_ctx_switch();
 	#endif
 }
 
 #endif
 
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if HW_TIMER_SIZE == 0 && OS_DYNAMIC_TICK
+
+static bool SUSPENDED = false; // the system timer interrupts are suppressed
+
+cnt_t core_sys_suspend( void )
+{
+	cnt_t cnt = core_tmr_delay();
+
+	if (cnt > 1 && !SUSPENDED)
+		SUSPENDED = port_tck_suspend(cnt);
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void core_sys_resume( cnt_t cnt )
+{
+	cnt_t tck;
+
+	port_set_lock();
+	tck = port_tck_resume();
+	if (!SUSPENDED || cnt < tck)
+		cnt = tck;
+	SUSPENDED = false;
+	System.cnt += cnt;
+	port_clr_lock();
+
+	if (cnt)
+		core_tmr_handler();
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 void core_tsk_idle( void )
 {
+#if HW_TIMER_SIZE == 0 && OS_DYNAMIC_TICK
+	port_set_lock();
+	core_sys_suspend();
+	port_cpu_sleep();
+	core_sys_resume(0);
+	port_clr_lock();
+#else
 	__WFI();
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
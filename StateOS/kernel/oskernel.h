@@ -32,6 +32,7 @@
 #ifndef __STATEOSKERNEL_H
 #define __STATEOSKERNEL_H
 
+#include <stddef.h>
 #include <string.h>
 #include <stdlib.h>
 #include "oscore.h"
@@ -81,10 +82,41 @@ extern "C" {
 
 /* -------------------------------------------------------------------------- */
 
+#ifndef port_cpu_id
+#define port_cpu_id()       0U // ports without multi-core mode run on one processor
+#endif
+
 extern tsk_t MAIN;   // main task
-extern tsk_t IDLE;   // idle task, tasks' queue
 extern tmr_t WAIT;   // timers' queue
+#if OS_CPU_COUNT > 1
+extern sys_t System_CPU[OS_CPU_COUNT]; // system data of the processors
+
+#define System System_CPU[port_cpu_id()] // system data of the current processor
+#define IDLE (*System.idle)              // idle task, tasks' queue of the current processor
+#else
+extern tsk_t IDLE;   // idle task, tasks' queue
 extern sys_t System; // system data
+#endif
+
+#if OS_TIMER_DAEMON
+
+// timer daemon data
+
+typedef struct __dmn
+{
+	tmr_t  * head;  // first timer with pending callbacks
+	tmr_t  * tail;  // last timer with pending callbacks
+	tmr_t  * cur;   // timer whose callback is executed by the daemon
+	tsk_t  * queue; // timer daemon waiting for pending callbacks
+
+}	dmn_t;
+
+extern dmn_t DAEMON; // timer daemon data
+#endif
+
+#if OS_TIMER_SLACK
+extern unsigned MERGED; // number of timer expirations served together with another one
+#endif
 
 /* -------------------------------------------------------------------------- */
 
@@ -106,7 +138,8 @@ void port_sys_init( void );
 /* -------------------------------------------------------------------------- */
 
 // initiate task 'tsk' for context switch
-void core_ctx_init( tsk_t *tsk );
+// return false if the shared stack of the basic task cannot be allocated
+bool core_ctx_init( tsk_t *tsk );
 
 // save status of the current process and force yield system control to the next
 void core_ctx_switch( void );
@@ -130,6 +163,30 @@ void core_ctx_reset( void )
 	port_ctx_reset();
 }
 
+// lock the scheduler of the current processor; task switching is deferred, interrupts remain enabled
+__STATIC_INLINE
+void core_sch_lock( void )
+{
+	System.hold++;
+}
+
+// unlock the scheduler of the current processor; the deferred task switch is forced when the lock is released completely
+void core_sch_unlock( void );
+
+#if OS_ISR_LOCKFREE
+
+// record the post of the interrupt handler in 'pnd' without disabling the interrupts
+// core_pnd_add adds 'val' to the pending counter, core_pnd_set sets bits 'val' in the pending bit mask
+// the first post appends the object to the list of pending objects and requests the kernel handler,
+// which resolves all pending posts with 'fun'
+void core_pnd_add( pnd_t *pnd, pnd_fun *fun, unsigned val );
+void core_pnd_set( pnd_t *pnd, pnd_fun *fun, unsigned val );
+
+// resolve all pending posts of the interrupt handlers; use only in the critical section
+void core_pnd_flush( void );
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 // insert timer 'tmr' into timers READY queue with id 'id' and start it
@@ -138,9 +195,21 @@ void core_tmr_insert( tmr_t *tmr, tid_t id );
 // remove timer 'tmr' from timers READY queue
 void core_tmr_remove( tmr_t *tmr );
 
+// return timer / task following 'tmr' in timers READY queue; WAIT begins and ends the queue
+tmr_t *core_tmr_next( tmr_t *tmr );
+
 // timers queue handler procedure
 void core_tmr_handler( void );
 
+// return number of ticks to the nearest timer event; INFINITE if no timer counts
+cnt_t core_tmr_delay( void );
+
+#if OS_TIME_NSEC
+// return value of the monotonic clock in units of the runtime counter (RUN_FREQUENCY)
+// lock-free, may be used both in thread and handler mode; the clock is started with the first call
+uint64_t core_clk_time( void );
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 // reset stack and restart the current task
@@ -219,11 +288,24 @@ tsk_t *core_one_wakeup( tsk_t *tsk, unsigned event )
 // remove all resumed tasks from timers READY queue
 // insert all resumed tasks into tasks READY queue
 // force context switch if priority of any resumed task is greater then priority of the current task and kernel works in preemptive mode
-void core_all_wakeup( tsk_t *tsk, unsigned event );
+// 'lck' is the interrupts state saved at the entry to the critical section (see core_hld_init)
+void core_all_wakeup( tsk_t *tsk, unsigned event, lck_t lck );
 
 // return count of tasks blocked on the queue; 'tsk' is the head (first task) of the queue
 unsigned core_tsk_count( tsk_t *tsk );
 
+// proxy: task control block without a stack, which is never scheduled (used by the coroutines, see oscoroutine.h)
+// it waits in the blocked queue of an object in place of a task; objects serve it like any other waiting task
+// when the proxy is resumed, its 'state' field is called as the procedure of type 'prx_t' with the proxy as the argument
+// instead of inserting the proxy into tasks READY queue
+typedef void prx_t( tsk_t *prx );
+
+#define core_tsk_proxy( tsk ) ((tsk)->stack == 0)
+
+// append the proxy 'prx' to the blocked queue 'que' for given duration of time 'delay'
+// insert the proxy into timers READY queue
+void core_prx_wait( tsk_t *prx, tsk_t **que, cnt_t delay );
+
 // set task 'tsk' priority
 // force context switch if new priority of task 'tsk' is greater then priority of current task and kernel works in preemptive mode
 void core_tsk_prio( tsk_t *tsk, unsigned prio );
@@ -232,6 +314,12 @@ void core_tsk_prio( tsk_t *tsk, unsigned prio );
 // force context switch if new priority of the current task is less then priority of next task in ready queue and kernel works in preemptive mode
 void core_cur_prio( unsigned prio );
 
+#if OS_EDF_PRIO
+// set the absolute deadline of the current task
+// the task belonging to the EDF band is moved to the new position in ready queue; force context switch if it is not the first one
+void core_cur_deadline( cnt_t deadline );
+#endif
+
 // tasks queue handler procedure
 // save stack pointer 'sp' of the current task
 // reset context switch timer counter
@@ -246,6 +334,10 @@ void core_mtx_link( mtx_t *mtx, tsk_t *tsk );
 // remove owner of the mutex 'mtx'
 void core_mtx_unlink( mtx_t *mtx );
 
+// update the priority inherited by the owner from the mutex 'mtx'; 'prio' is the priority of the task being blocked on the mutex
+// the mutex is moved to the new position in the list of mutexes held by the owner and the owner priority is updated
+void core_mtx_update( mtx_t *mtx, unsigned prio );
+
 // transfer lock to the next task in the blocked queue of mutex 'mtx'
 // the task is waked with event 'event'
 // return pointer to the waked task or 0 if the blocked queue of 'mtx' is empty
@@ -253,6 +345,17 @@ tsk_t *core_mtx_transferLock( mtx_t *mtx, unsigned event );
 
 /* -------------------------------------------------------------------------- */
 
+#if OS_BUDGET
+// update priorities of all tasks attached to the budget reservation 'bgt'
+// the tasks are demoted to the background priority of 'bgt' if the budget has been exhausted
+void core_bgt_update( bgt_t *bgt );
+
+// replenishment procedure of the budget reservation, called as the callback of its timer
+void core_bgt_handler( void );
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 // return current system time in tick-less mode
 #if HW_TIMER_SIZE < OS_TIMER_SIZE // because of CSMCC
 cnt_t port_sys_time( void );
@@ -262,13 +365,126 @@ cnt_t port_sys_time( void );
 __STATIC_INLINE
 cnt_t core_sys_time( void )
 {
-#if HW_TIMER_SIZE == 0
+#if HW_TIMER_SIZE == 0 && OS_CPU_COUNT > 1
+	return System_CPU[0].cnt; // the system timer is served by the first processor
+#elif HW_TIMER_SIZE == 0
 	return System.cnt;
 #else
 	return port_sys_time();
 #endif
 }
 
+#if OS_TASK_RUNTIME || OS_TRACE || OS_TIME_NSEC || OS_LOCK_STATS
+
+// frequency of the runtime counter, if not defined by the port
+#ifndef RUN_FREQUENCY
+#ifdef  port_run_time
+#define RUN_FREQUENCY CPU_FREQUENCY
+#else
+#define RUN_FREQUENCY OS_FREQUENCY
+#endif
+#endif
+
+// return current value of the runtime counter
+// processor cycle counter if provided by the port, system timer counter otherwise
+__STATIC_INLINE
+uint32_t core_run_time( void )
+{
+#ifdef  port_run_time
+	return port_run_time();
+#else
+	return (uint32_t)core_sys_time();
+#endif
+}
+
+#endif
+
+// identifiers of the bounded kernel loops
+
+#define LCK_WAKEUP    0 // broadcast wakeup of the blocked queue
+#define LCK_FLAG      1 // scan of the tasks waiting for the flags
+#define LCK_STREAM    2 // transfer of the stream buffer data to the waiting tasks
+#define LCK_HEAP      3 // walk through the system heap
+#define LCK_DESTROY   4 // destruction of the stopped tasks
+#define LCK_COUNT     5
+
+// state of the kernel loop executed in the critical section
+
+typedef struct __hld
+{
+	unsigned cnt;   // number of iterations since the entry or the last window
+#if OS_LOCK_SPAN
+	lck_t    lck;   // interrupts state saved at the entry to the critical section
+#endif
+#if OS_LOCK_STATS
+	unsigned fun;   // identifier of the kernel loop
+	uint32_t run;   // value of the runtime counter at the beginning of the lock hold
+#endif
+
+}	hld_t;
+
+// start the kernel loop 'fun' in the critical section entered with the interrupts state 'lck'
+__STATIC_INLINE
+void core_hld_init( hld_t *hld, unsigned fun, lck_t lck )
+{
+	hld->cnt = 0;
+#if OS_LOCK_SPAN
+	hld->lck = lck;
+#else
+	(void) lck;
+#endif
+#if OS_LOCK_STATS
+	hld->fun = fun;
+	hld->run = core_run_time();
+#else
+	(void) fun;
+#endif
+}
+
+// count the iteration of the kernel loop
+// return true every OS_LOCK_SPAN iterations, unless the interrupts were already disabled at the entry to the critical section
+// then open the interrupt window with core_hld_window; the scheduler is held for the time of the window,
+// so only the interrupt handlers can run in it; return true if they have changed any blocked queue
+#if OS_LOCK_SPAN
+__STATIC_INLINE
+bool core_hld_tick( hld_t *hld )
+{
+	if (++hld->cnt < OS_LOCK_SPAN)
+		return false;
+
+	hld->cnt = 0;
+	return hld->lck != port_get_lock();
+}
+
+bool core_hld_window( hld_t *hld );
+#else
+__STATIC_INLINE
+bool core_hld_tick( hld_t *hld ) { (void) hld; return false; }
+__STATIC_INLINE
+bool core_hld_window( hld_t *hld ) { (void) hld; return false; }
+#endif
+
+// finish the kernel loop and record the time of the lock hold
+#if OS_LOCK_STATS
+void core_hld_done( hld_t *hld );
+#else
+__STATIC_INLINE
+void core_hld_done( hld_t *hld ) { (void) hld; }
+#endif
+
+#if OS_LOCK_STATS
+// return the longest time of the lock hold recorded for the kernel loop 'fun' (in units of the runtime counter) and reset it
+uint32_t core_hld_max( unsigned fun );
+#endif
+
+#if OS_TASK_RUNTIME
+
+// add the time elapsed since the last accounting to the runtime of the current task
+// the runtime counter must be accounted at least once per its period
+void core_run_account( void );
+
+#endif
+
 // internal handler of system timer
 #if HW_TIMER_SIZE == 0
 void core_sys_tick( void );
@@ -282,6 +498,19 @@ void core_sys_tick( void )
 }
 #endif
 
+#if HW_TIMER_SIZE == 0 && OS_DYNAMIC_TICK
+
+// suppress the system timer interrupts until the nearest timer event
+// return number of ticks to the nearest timer event; INFINITE if no timer counts
+cnt_t core_sys_suspend( void );
+
+// restore the system timer interrupts and count the ticks elapsed since the suppression
+// 'cnt': number of ticks measured by the caller; used if the interrupts have been suppressed
+//        and the value is greater than measured by the system timer
+void core_sys_resume( cnt_t cnt );
+
+#endif
+
 // default handler of idle process
 void core_tsk_idle( void );
 
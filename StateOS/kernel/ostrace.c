@@ -0,0 +1,56 @@
+/******************************************************************************
+
+    @file    StateOS: ostrace.c
+    @author  Rajmund Szymanski
+    @date    17.10.2018
+    @brief   This file provides set of variables and functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "ostrace.h"
+#include "inc/oscriticalsection.h"
+
+/* -------------------------------------------------------------------------- */
+// SYSTEM TRACE SERVICES
+/* -------------------------------------------------------------------------- */
+
+#if OS_TRACE
+
+trc_t Trace = { .magic=TRC_MAGIC, .size=sizeof(trc_rec_t), .count=OS_TRACE, .freq=RUN_FREQUENCY, .cpus=OS_CPU_COUNT };
+
+/* -------------------------------------------------------------------------- */
+
+void sys_trace( unsigned event, const void *obj )
+{
+	sys_lock();
+	{
+		core_trc_event(event, obj, System.cur);
+	}
+	sys_unlock();
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,159 @@
+/******************************************************************************
+
+    @file    StateOS: ostrace.h
+    @author  Rajmund Szymanski
+    @date    17.10.2018
+    @brief   This file contains definitions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOSTRACE_H
+#define __STATEOSTRACE_H
+
+#include "oskernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#define TRC_MAGIC    0x43525453UL // "STRC", identifies the trace buffer in a memory dump
+
+#define TRC_SWITCH   0x01 // context switch: obj = previous task,                 tsk = next task
+#define TRC_WAKEUP   0x02 // task wakeup:    obj = blocked queue of the object,   tsk = resumed task
+#define TRC_BLOCK    0x03 // task blocking:  obj = blocked queue of the object,   tsk = blocked task
+#define TRC_TIMER    0x04 // timer expiry:   obj = timer,                         tsk = current task
+#define TRC_USER     0x80 // first identifier of the user events (sys_trace)
+
+/******************************************************************************
+ *
+ * Name              : trace record
+ *
+ ******************************************************************************/
+
+typedef struct __trc_rec
+{
+	uint32_t time;  // value of the runtime counter
+	uint16_t event; // event identifier
+	uint16_t cpu;   // index of the processor
+	const
+	void   * obj;   // object of the event
+	const
+	void   * tsk;   // task of the event
+
+}	trc_rec_t;
+
+/******************************************************************************
+ *
+ * Name              : trace buffer
+ *
+ ******************************************************************************/
+
+typedef struct __trc
+{
+	uint32_t magic; // TRC_MAGIC
+	uint32_t size;  // size of the record (in bytes)
+	uint32_t count; // number of records in the ring buffer (OS_TRACE)
+	uint32_t freq;  // frequency of the runtime counter (in Hz)
+	uint32_t cpus;  // number of processors (OS_CPU_COUNT)
+	uint32_t head;  // number of recorded events
+	trc_rec_t rec[OS_TRACE ? OS_TRACE : 1];
+
+}	trc_t;
+
+#if OS_TRACE
+extern trc_t Trace; // trace buffer
+#endif
+
+/******************************************************************************
+ *
+ * Name              : core_trc_event
+ *
+ * Description       : write the event to the trace buffer, the oldest record is overwritten
+ *
+ * Parameters
+ *   event           : event identifier
+ *   obj             : object of the event
+ *   tsk             : task of the event
+ *
+ * Return            : none
+ *
+ * Note              : for internal use; must be called inside the critical section
+ *                     does not generate any code when OS_TRACE == 0
+ *
+ ******************************************************************************/
+
+__STATIC_INLINE
+void core_trc_event( unsigned event, const void *obj, const void *tsk )
+{
+#if OS_TRACE
+	trc_rec_t *rec = &Trace.rec[Trace.head++ & (OS_TRACE - 1)];
+
+	rec->time  = core_run_time();
+	rec->event = (uint16_t) event;
+	rec->cpu   = (uint16_t) port_cpu_id();
+	rec->obj   = obj;
+	rec->tsk   = tsk;
+#else
+	(void) event;
+	(void) obj;
+	(void) tsk;
+#endif
+}
+
+/******************************************************************************
+ *
+ * Name              : sys_trace
+ * ISR alias         : sys_traceISR
+ *
+ * Description       : write the user event to the trace buffer
+ *
+ * Parameters
+ *   event           : event identifier (TRC_USER .. 0xFFFF)
+ *   obj             : object of the event
+ *
+ * Return            : none
+ *
+ * Note              : may be used both in thread and handler mode
+ *                     does nothing when OS_TRACE == 0
+ *
+ ******************************************************************************/
+
+#if OS_TRACE
+void sys_trace( unsigned event, const void *obj );
+#else
+__STATIC_INLINE
+void sys_trace( unsigned event, const void *obj ) { (void) event; (void) obj; }
+#endif
+
+__STATIC_INLINE
+void sys_traceISR( unsigned event, const void *obj ) { sys_trace(event, obj); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//__STATEOSTRACE_H
@@ -82,7 +82,7 @@ void bar_kill( bar_t *bar )
 
 	sys_lock();
 	{
-		core_all_wakeup(bar->obj.queue, E_STOPPED);
+		core_all_wakeup(bar->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -105,12 +105,12 @@ void bar_delete( bar_t *bar )
 
 /* -------------------------------------------------------------------------- */
 static
-unsigned priv_bar_take( bar_t *bar )
+unsigned priv_bar_take( bar_t *bar, lck_t lck )
 /* -------------------------------------------------------------------------- */
 {
 	if (core_tsk_count(bar->obj.queue) + 1 == bar->limit)
 	{
-		core_all_wakeup(bar->obj.queue, E_SUCCESS);
+		core_all_wakeup(bar->obj.queue, E_SUCCESS, lck);
 
 		return E_SUCCESS;
 	}
@@ -131,7 +131,7 @@ unsigned bar_waitFor( bar_t *bar, cnt_t delay )
 
 	sys_lock();
 	{
-		event = priv_bar_take(bar);
+		event = priv_bar_take(bar, core_lck_saved());
 
 		if (event == E_TIMEOUT)
 			event = core_tsk_waitFor(&bar->obj.queue, delay);
@@ -154,7 +154,7 @@ unsigned bar_waitUntil( bar_t *bar, cnt_t time )
 
 	sys_lock();
 	{
-		event = priv_bar_take(bar);
+		event = priv_bar_take(bar, core_lck_saved());
 
 		if (event == E_TIMEOUT)
 			event = core_tsk_waitUntil(&bar->obj.queue, time);
@@ -0,0 +1,222 @@
+/******************************************************************************
+
+    @file    StateOS: osbudget.c
+    @author  Rajmund Szymanski
+    @date    17.10.2018
+    @brief   This file provides set of functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+
+#include "inc/osbudget.h"
+#include "inc/ostask.h"
+#include "inc/oscriticalsection.h"
+#include "osalloc.h"
+
+#if OS_BUDGET
+
+/* -------------------------------------------------------------------------- */
+void bgt_init( bgt_t *bgt, cnt_t budget, cnt_t period, unsigned prio )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(bgt);
+
+	sys_lock();
+	{
+		memset(bgt, 0, sizeof(bgt_t));
+
+		core_hdr_init(&bgt->tmr.hdr);
+
+		bgt->tmr.state  = core_bgt_handler;
+		bgt->tmr.period = period;
+		bgt->budget     = budget;
+		bgt->left       = budget;
+		bgt->prio       = prio;
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+bgt_t *bgt_create( cnt_t budget, cnt_t period, unsigned prio )
+/* -------------------------------------------------------------------------- */
+{
+	bgt_t *bgt;
+
+	assert_tsk_context();
+
+	sys_lock();
+	{
+		bgt = sys_alloc(sizeof(bgt_t));
+		bgt_init(bgt, budget, period, prio);
+		bgt->tmr.hdr.obj.res = bgt;
+	}
+	sys_unlock();
+
+	return bgt;
+}
+
+/* -------------------------------------------------------------------------- */
+void bgt_start( bgt_t *bgt )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(bgt);
+	assert(bgt->tmr.hdr.obj.res!=RELEASED);
+	assert(bgt->tmr.period);
+
+	sys_lock();
+	{
+		if (bgt->tmr.hdr.id == ID_TIMER)
+			core_tmr_remove(&bgt->tmr);
+
+		bgt->tmr.start = core_sys_time();
+		bgt->tmr.delay = bgt->tmr.period;
+		core_tmr_insert(&bgt->tmr, ID_TIMER);
+
+		bgt->left = bgt->budget;
+		core_bgt_update(bgt);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void bgt_kill( bgt_t *bgt )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(bgt);
+	assert(bgt->tmr.hdr.obj.res!=RELEASED);
+
+	sys_lock();
+	{
+		if (bgt->tmr.hdr.id == ID_TIMER)
+			core_tmr_remove(&bgt->tmr);
+
+		bgt->left = bgt->budget;
+		core_bgt_update(bgt);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void bgt_delete( bgt_t *bgt )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(bgt);
+	assert(bgt->tmr.hdr.obj.res!=RELEASED);
+
+	sys_lock();
+	{
+		bgt_kill(bgt);
+		while (bgt->list)
+			bgt_detach(bgt->list);
+		core_res_free(&bgt->tmr.hdr.obj.res);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_bgt_remove( tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	bgt_t *bgt = tsk->bgt.owner;
+	tsk_t *prv;
+
+	if (bgt)
+	{
+		if (bgt->list == tsk)
+			bgt->list = tsk->bgt.next;
+
+		for (prv = bgt->list; prv; prv = prv->bgt.next)
+			if (prv->bgt.next == tsk)
+				prv->bgt.next = tsk->bgt.next;
+
+		tsk->bgt.owner = 0;
+		tsk->bgt.next  = 0;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+void bgt_attach( bgt_t *bgt, tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(bgt);
+	assert(bgt->tmr.hdr.obj.res!=RELEASED);
+	assert(tsk);
+
+	sys_lock();
+	{
+		priv_bgt_remove(tsk);
+
+		tsk->bgt.owner = bgt;
+		tsk->bgt.next  = bgt->list;
+		bgt->list = tsk;
+
+		core_tsk_prio(tsk, 0);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void bgt_detach( tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(tsk);
+
+	sys_lock();
+	{
+		priv_bgt_remove(tsk);
+
+		core_tsk_prio(tsk, 0);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+cnt_t bgt_getLeft( bgt_t *bgt )
+/* -------------------------------------------------------------------------- */
+{
+	cnt_t left;
+
+	assert(bgt);
+	assert(bgt->tmr.hdr.obj.res!=RELEASED);
+
+	sys_lock();
+	{
+		left = bgt->left;
+	}
+	sys_unlock();
+
+	return left;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_BUDGET
@@ -78,7 +78,7 @@ void cnd_kill( cnd_t *cnd )
 
 	sys_lock();
 	{
-		core_all_wakeup(cnd->obj.queue, E_STOPPED);
+		core_all_wakeup(cnd->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
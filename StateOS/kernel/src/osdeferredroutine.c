@@ -0,0 +1,147 @@
+/******************************************************************************
+
+    @file    StateOS: osdeferredroutine.c
+    @author  Rajmund Szymanski
+    @date    17.10.2018
+    @brief   This file provides set of functions for StateOS.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "inc/osdeferredroutine.h"
+#include "inc/ostask.h"
+#include "inc/oscriticalsection.h"
+
+#if OS_DSR_LEVELS
+
+// every level has its own lock-free queue of the posted routines (pushed by the interrupt handlers in LIFO order)
+// and its own worker task, which takes the whole queue at once and executes the routines in order of their posts
+
+static void * volatile DSR_QUE[OS_DSR_LEVELS]; // queues of the posted routines
+static tsk_t         * DSR_WAI[OS_DSR_LEVELS]; // workers waiting for the posted routines
+static tsk_t           DSR_WRK[OS_DSR_LEVELS]; // worker tasks
+static stk_t           DSR_STK[OS_DSR_LEVELS][STK_SIZE(OS_STACK_SIZE)];
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_dsr_worker( void )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned lvl = (unsigned)(tsk_this() - DSR_WRK);
+	dsr_t  * dsr;
+	dsr_t  * nxt;
+	dsr_t  * lst = 0;
+	void   * arg;
+
+	sys_lock();
+	{
+		while (DSR_QUE[lvl] == 0)
+			core_tsk_waitFor(&DSR_WAI[lvl], INFINITE);
+	}
+	sys_unlock();
+
+	do dsr = DSR_QUE[lvl];
+	while (!port_atm_cas(&DSR_QUE[lvl], dsr, 0));
+
+	for (; dsr; dsr = nxt) // restore the order of the posts
+	{
+		nxt = dsr->next;
+		dsr->next = lst;
+		lst = dsr;
+	}
+
+	for (dsr = lst; dsr; dsr = nxt)
+	{
+		nxt = dsr->next; // the routine may be posted again as soon as it is no longer pending
+		port_atm_swap(&dsr->pend, 0);
+		arg = dsr->arg;
+		dsr->fun(arg);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+__CONSTRUCTOR
+static
+void priv_dsr_start( void )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned lvl;
+
+	port_sys_init();
+
+	for (lvl = 0; lvl < OS_DSR_LEVELS; lvl++)
+		tsk_init(&DSR_WRK[lvl], OS_DSR_PRIO + lvl, priv_dsr_worker, DSR_STK[lvl], sizeof(DSR_STK[lvl]));
+}
+
+/* -------------------------------------------------------------------------- */
+void dsr_init( dsr_t *dsr, unsigned prio, act_t *fun )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(dsr);
+	assert(dsr->pend == 0);
+	assert(prio < OS_DSR_LEVELS);
+	assert(fun);
+
+	sys_lock();
+	{
+		memset(dsr, 0, sizeof(dsr_t));
+
+		dsr->fun  = fun;
+		dsr->prio = prio;
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+void dsr_give( dsr_t *dsr, void *arg )
+/* -------------------------------------------------------------------------- */
+{
+	void *que;
+
+	assert(dsr);
+	assert(dsr->prio < OS_DSR_LEVELS);
+	assert(dsr->fun);
+
+	dsr->arg = arg;
+
+	if (port_atm_add(&dsr->pend, 1) != 0) // the routine is already pending
+		return;
+
+	do dsr->next = que = DSR_QUE[dsr->prio];
+	while (!port_atm_cas(&DSR_QUE[dsr->prio], que, dsr));
+
+	if (que == 0) // the first post of the batch
+	{
+		sys_lock();
+		{
+			core_one_wakeup(DSR_WAI[dsr->prio], E_SUCCESS);
+		}
+		sys_unlock();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+#endif//OS_DSR_LEVELS
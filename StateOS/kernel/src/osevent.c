@@ -76,7 +76,7 @@ void evt_kill( evt_t *evt )
 
 	sys_lock();
 	{
-		core_all_wakeup(evt->obj.queue, E_STOPPED);
+		core_all_wakeup(evt->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -144,7 +144,7 @@ void evt_give( evt_t *evt, unsigned event )
 
 	sys_lock();
 	{
-		core_all_wakeup(evt->obj.queue, event);
+		core_all_wakeup(evt->obj.queue, event, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -91,7 +91,7 @@ void evq_kill( evq_t *evq )
 		evq->head  = 0;
 		evq->tail  = 0;
 
-		core_all_wakeup(evq->obj.queue, E_STOPPED);
+		core_all_wakeup(evq->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -165,11 +165,17 @@ static
 void priv_evq_putUpdate( evq_t *evq, const unsigned data )
 /* -------------------------------------------------------------------------- */
 {
-	tsk_t *tsk;
+	tsk_t *tsk = evq->obj.queue;
 
-	priv_evq_put(evq, data);
-	tsk = core_one_wakeup(evq->obj.queue, E_SUCCESS);
-	if (tsk) priv_evq_get(evq, tsk->tmp.evq.data.in);
+	if (tsk == 0)
+	{
+		priv_evq_put(evq, data);
+		return;
+	}
+
+	// the queue is empty and the task waits for data: hand the event directly over to the task
+	*tsk->tmp.evq.data.in = data;
+	core_tsk_wakeup(tsk, E_SUCCESS);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -78,7 +78,7 @@ void mut_kill( mut_t *mut )
 
 	sys_lock();
 	{
-		core_all_wakeup(mut->obj.queue, E_STOPPED);
+		core_all_wakeup(mut->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -81,9 +81,12 @@ void flg_kill( flg_t *flg )
 
 	sys_lock();
 	{
+#if OS_ISR_LOCKFREE
+		core_pnd_flush();
+#endif
 		flg->flags = 0;
 
-		core_all_wakeup(flg->obj.queue, E_STOPPED);
+		core_all_wakeup(flg->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -206,44 +209,91 @@ unsigned flg_waitUntil( flg_t *flg, unsigned flags, char mode, cnt_t time )
 }
 
 /* -------------------------------------------------------------------------- */
-unsigned flg_give( flg_t *flg, unsigned flags )
+static
+unsigned priv_flg_give( flg_t *flg, unsigned flags, lck_t lck )
 /* -------------------------------------------------------------------------- */
 {
 	obj_t *obj;
 	tsk_t *tsk;
+	hld_t  hld;
 
-	assert(flg);
-	assert(flg->obj.res!=RELEASED);
+	flg->flags |= flags;
 
-	sys_lock();
+	core_hld_init(&hld, LCK_FLAG, lck);
+
+	obj = &flg->obj;
+	while (obj->queue)
 	{
-		flg->flags |= flags;
+		if (core_hld_tick(&hld) && core_hld_window(&hld))
+		{
+		//	the scan is restarted; the tasks already served do not wait for the given flags any longer
+			obj = &flg->obj;
+			continue;
+		}
 
-		obj = &flg->obj;
-		while (obj->queue)
+		tsk = obj->queue;
+		if (tsk->tmp.flg.flags & flags)
 		{
-			tsk = obj->queue;
-			if (tsk->tmp.flg.flags & flags)
+			if ((tsk->tmp.flg.mode & flgProtect) == 0)
+				flg->flags &= ~(tsk->tmp.flg.flags & flags);
+			tsk->tmp.flg.flags &= ~flags;
+			if (tsk->tmp.flg.flags == 0 || (tsk->tmp.flg.mode & flgAll) == 0)
 			{
-				if ((tsk->tmp.flg.mode & flgProtect) == 0)
-					flg->flags &= ~(tsk->tmp.flg.flags & flags);
-				tsk->tmp.flg.flags &= ~flags;
-				if (tsk->tmp.flg.flags == 0 || (tsk->tmp.flg.mode & flgAll) == 0)
-				{
-					core_tsk_wakeup(tsk, E_SUCCESS);
-					continue;
-				}
+				core_tsk_wakeup(tsk, E_SUCCESS);
+				continue;
 			}
-			obj = &tsk->hdr.obj;
 		}
+		obj = &tsk->hdr.obj;
+	}
 
-		flags = flg->flags;
+	core_hld_done(&hld);
+
+	return flg->flags;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned flg_give( flg_t *flg, unsigned flags )
+/* -------------------------------------------------------------------------- */
+{
+	assert(flg);
+	assert(flg->obj.res!=RELEASED);
+
+	sys_lock();
+	{
+		flags = priv_flg_give(flg, flags, core_lck_saved());
 	}
 	sys_unlock();
 
 	return flags;
 }
 
+#if OS_ISR_LOCKFREE
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_flg_resolve( pnd_t *pnd, unsigned flags )
+/* -------------------------------------------------------------------------- */
+{
+	flg_t *flg = (flg_t *)((char *)pnd - offsetof(flg_t, pnd));
+
+	priv_flg_give(flg, flags, port_get_lock());
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned flg_giveISR( flg_t *flg, unsigned flags )
+/* -------------------------------------------------------------------------- */
+{
+	assert(flg);
+	assert(flg->obj.res!=RELEASED);
+
+	if (flags)
+		core_pnd_set(&flg->pnd, priv_flg_resolve, flags);
+
+	return flg->flags | flg->pnd.pend;
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 unsigned flg_clear( flg_t *flg, unsigned flags )
 /* -------------------------------------------------------------------------- */
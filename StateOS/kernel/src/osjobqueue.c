@@ -91,7 +91,7 @@ void job_kill( job_t *job )
 		job->head  = 0;
 		job->tail  = 0;
 
-		core_all_wakeup(job->obj.queue, E_STOPPED);
+		core_all_wakeup(job->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -164,11 +164,17 @@ static
 void priv_job_putUpdate( job_t *job, fun_t *fun )
 /* -------------------------------------------------------------------------- */
 {
-	tsk_t *tsk;
+	tsk_t *tsk = job->obj.queue;
 
-	priv_job_put(job, fun);
-	tsk = core_one_wakeup(job->obj.queue, E_SUCCESS);
-	if (tsk) priv_job_get(job, tsk->tmp.job.data.in);
+	if (tsk == 0)
+	{
+		priv_job_put(job, fun);
+		return;
+	}
+
+	// the queue is empty and the task waits for a job: hand the job directly over to the task
+	*tsk->tmp.job.data.in = fun;
+	core_tsk_wakeup(tsk, E_SUCCESS);
 }
 
 /* -------------------------------------------------------------------------- */
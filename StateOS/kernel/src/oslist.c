@@ -79,7 +79,7 @@ void lst_kill( lst_t *lst )
 
 	sys_lock();
 	{
-		core_all_wakeup(lst->obj.queue, E_STOPPED);
+		core_all_wakeup(lst->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -94,7 +94,7 @@ void box_kill( box_t *box )
 		box->head  = 0;
 		box->tail  = 0;
 
-		core_all_wakeup(box->obj.queue, E_STOPPED);
+		core_all_wakeup(box->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -170,11 +170,20 @@ static
 void priv_box_putUpdate( box_t *box, const char *data )
 /* -------------------------------------------------------------------------- */
 {
-	tsk_t *tsk;
+	tsk_t *tsk = box->obj.queue;
+	char  *buf;
+	unsigned j = 0;
 
-	priv_box_put(box, data);
-	tsk = core_one_wakeup(box->obj.queue, E_SUCCESS);
-	if (tsk) priv_box_get(box, tsk->tmp.box.data.in);
+	if (tsk == 0)
+	{
+		priv_box_put(box, data);
+		return;
+	}
+
+	// the queue is empty and the task waits for data: hand the message directly over to the task
+	buf = tsk->tmp.box.data.in;
+	do buf[j] = data[j]; while (++j < box->size);
+	core_tsk_wakeup(tsk, E_SUCCESS);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -116,7 +116,7 @@ void mem_kill( mem_t *mem )
 
 	sys_lock();
 	{
-		core_all_wakeup(mem->lst.obj.queue, E_STOPPED);
+		core_all_wakeup(mem->lst.obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
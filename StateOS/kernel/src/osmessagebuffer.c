@@ -91,7 +91,7 @@ void msg_kill( msg_t *msg )
 		msg->head  = 0;
 		msg->tail  = 0;
 
-		core_all_wakeup(msg->obj.queue, E_STOPPED);
+		core_all_wakeup(msg->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
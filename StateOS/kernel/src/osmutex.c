@@ -42,7 +42,6 @@ void mtx_init( mtx_t *mtx, unsigned mode, unsigned prio )
 	assert(mtx);
 	assert((mtx->mode & ~mtxMASK) == 0);
 	assert((mtx->mode &  mtxTypeMASK) != mtxTypeMASK);
-	assert((mtx->mode &  mtxPrioMASK) != mtxPrioMASK);
 
 	sys_lock();
 	{
@@ -86,7 +85,7 @@ void mtx_kill( mtx_t *mtx )
 	sys_lock();
 	{
 		core_mtx_unlink(mtx);
-		core_all_wakeup(mtx->obj.queue, E_STOPPED);
+		core_all_wakeup(mtx->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -119,9 +118,11 @@ void mtx_setPrio( mtx_t *mtx, unsigned prio )
 	{
 		mtx->prio = prio;
 
-		if ((mtx->mode & mtxPrioMASK) == mtxPrioProtect)
+		if ((mtx->mode & mtxPrioProtect))
 			while (mtx->obj.queue && mtx->obj.queue->prio > prio)
 				core_one_wakeup(mtx->obj.queue, E_FAILURE);
+
+		core_mtx_update(mtx, 0);
 	}
 	sys_unlock();
 }
@@ -153,6 +154,9 @@ unsigned priv_mtx_take( mtx_t *mtx )
 	if ((mtx->mode & mtxPrioMASK) == mtxPrioProtect && mtx->prio < System.cur->prio)
 		return E_FAILURE;
 
+	if ((mtx->mode & mtxPrioMASK) == mtxPrioSRP && mtx->prio < System.cur->basic)
+		return E_FAILURE;
+
 	if (mtx->owner == 0)
 	{
 		assert(mtx->count == 0);
@@ -191,7 +195,6 @@ unsigned mtx_take( mtx_t *mtx )
 	assert(mtx->obj.res!=RELEASED);
 	assert((mtx->mode & ~mtxMASK) == 0);
 	assert((mtx->mode &  mtxTypeMASK) != mtxTypeMASK);
-	assert((mtx->mode &  mtxPrioMASK) != mtxPrioMASK);
 
 	sys_lock();
 	{
@@ -213,7 +216,6 @@ unsigned mtx_waitFor( mtx_t *mtx, cnt_t delay )
 	assert(mtx->obj.res!=RELEASED);
 	assert((mtx->mode & ~mtxMASK) == 0);
 	assert((mtx->mode &  mtxTypeMASK) != mtxTypeMASK);
-	assert((mtx->mode &  mtxPrioMASK) != mtxPrioMASK);
 
 	sys_lock();
 	{
@@ -221,12 +223,15 @@ unsigned mtx_waitFor( mtx_t *mtx, cnt_t delay )
 
 		if (event == E_TIMEOUT)
 		{
-			if ((mtx->mode & mtxPrioMASK) != mtxPrioNone && mtx->owner->prio < System.cur->prio)
-				core_tsk_prio(mtx->owner, System.cur->prio);
+			core_mtx_update(mtx, System.cur->prio);
 
 			System.cur->mtx.tree = mtx;
 			event = core_tsk_waitFor(&mtx->obj.queue, delay);
-			System.cur->mtx.tree = 0;
+			if (System.cur->mtx.tree) // the task has not been blocked
+			{
+				System.cur->mtx.tree = 0;
+				core_mtx_update(mtx, 0);
+			}
 		}
 	}
 	sys_unlock();
@@ -245,7 +250,6 @@ unsigned mtx_waitUntil( mtx_t *mtx, cnt_t time )
 	assert(mtx->obj.res!=RELEASED);
 	assert((mtx->mode & ~mtxMASK) == 0);
 	assert((mtx->mode &  mtxTypeMASK) != mtxTypeMASK);
-	assert((mtx->mode &  mtxPrioMASK) != mtxPrioMASK);
 
 	sys_lock();
 	{
@@ -253,12 +257,15 @@ unsigned mtx_waitUntil( mtx_t *mtx, cnt_t time )
 
 		if (event == E_TIMEOUT)
 		{
-			if ((mtx->mode & mtxPrioMASK) != mtxPrioNone && mtx->owner->prio < System.cur->prio)
-				core_tsk_prio(mtx->owner, System.cur->prio);
+			core_mtx_update(mtx, System.cur->prio);
 
 			System.cur->mtx.tree = mtx;
 			event = core_tsk_waitUntil(&mtx->obj.queue, time);
-			System.cur->mtx.tree = 0;
+			if (System.cur->mtx.tree) // the task has not been blocked
+			{
+				System.cur->mtx.tree = 0;
+				core_mtx_update(mtx, 0);
+			}
 		}
 	}
 	sys_unlock();
@@ -297,7 +304,6 @@ unsigned mtx_give( mtx_t *mtx )
 	assert(mtx->obj.res!=RELEASED);
 	assert((mtx->mode & ~mtxMASK) == 0);
 	assert((mtx->mode &  mtxTypeMASK) != mtxTypeMASK);
-	assert((mtx->mode &  mtxPrioMASK) != mtxPrioMASK);
 
 	sys_lock();
 	{
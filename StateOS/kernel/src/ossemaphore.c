@@ -82,9 +82,12 @@ void sem_kill( sem_t *sem )
 
 	sys_lock();
 	{
+#if OS_ISR_LOCKFREE
+		core_pnd_flush();
+#endif
 		sem->count = 0;
 
-		core_all_wakeup(sem->obj.queue, E_STOPPED);
+		core_all_wakeup(sem->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -219,6 +222,32 @@ unsigned sem_give( sem_t *sem )
 	return event;
 }
 
+#if OS_ISR_LOCKFREE
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_sem_resolve( pnd_t *pnd, unsigned cnt )
+/* -------------------------------------------------------------------------- */
+{
+	sem_t *sem = (sem_t *)((char *)pnd - offsetof(sem_t, pnd));
+
+	while (cnt-- > 0 && priv_sem_give(sem) == E_SUCCESS);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned sem_giveISR( sem_t *sem )
+/* -------------------------------------------------------------------------- */
+{
+	assert(sem);
+	assert(sem->obj.res!=RELEASED);
+
+	core_pnd_add(&sem->pnd, priv_sem_resolve, 1);
+
+	return E_SUCCESS;
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 unsigned sem_sendFor( sem_t *sem, cnt_t delay )
 /* -------------------------------------------------------------------------- */
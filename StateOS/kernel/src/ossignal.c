@@ -83,7 +83,7 @@ void sig_kill( sig_t *sig )
 	{
 		sig->flags = 0;
 
-		core_all_wakeup(sig->obj.queue, E_STOPPED);
+		core_all_wakeup(sig->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -91,7 +91,7 @@ void stm_kill( stm_t *stm )
 		stm->head  = 0;
 		stm->tail  = 0;
 
-		core_all_wakeup(stm->obj.queue, E_STOPPED);
+		core_all_wakeup(stm->obj.queue, E_STOPPED, core_lck_saved());
 	}
 	sys_unlock();
 }
@@ -156,29 +156,41 @@ void priv_stm_skip( stm_t *stm, unsigned size )
 
 /* -------------------------------------------------------------------------- */
 static
-unsigned priv_stm_getUpdate( stm_t *stm, char *data, unsigned size )
+unsigned priv_stm_getUpdate( stm_t *stm, char *data, unsigned size, lck_t lck )
 /* -------------------------------------------------------------------------- */
 {
+	hld_t hld;
+
 	if (size > stm->count)
 		size = stm->count;
 	priv_stm_get(stm, data, size);
 
+	core_hld_init(&hld, LCK_STREAM, lck);
+
 	while (stm->obj.queue != 0 && stm->count + stm->obj.queue->tmp.stm.size <= stm->limit)
 	{
 		priv_stm_put(stm, stm->obj.queue->tmp.stm.data.out, stm->obj.queue->tmp.stm.size);
 		core_one_wakeup(stm->obj.queue, E_SUCCESS);
+		if (core_hld_tick(&hld))
+			core_hld_window(&hld);
 	}
 
+	core_hld_done(&hld);
+
 	return size;
 }
 
 /* -------------------------------------------------------------------------- */
 static
-void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
+void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size, lck_t lck )
 /* -------------------------------------------------------------------------- */
 {
+	hld_t hld;
+
 	priv_stm_put(stm, data, size);
 
+	core_hld_init(&hld, LCK_STREAM, lck);
+
 	while (stm->obj.queue != 0 && stm->count > 0)
 	{
 		size = stm->obj.queue->tmp.stm.size;
@@ -186,7 +198,11 @@ void priv_stm_putUpdate( stm_t *stm, const char *data, unsigned size )
 			size = stm->count;
 		priv_stm_get(stm, stm->obj.queue->tmp.stm.data.in, size);
 		core_one_wakeup(stm->obj.queue, size);
+		if (core_hld_tick(&hld))
+			core_hld_window(&hld);
 	}
+
+	core_hld_done(&hld);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -208,11 +224,11 @@ void priv_stm_skipUpdate( stm_t *stm, unsigned size )
 
 /* -------------------------------------------------------------------------- */
 static
-unsigned priv_stm_take( stm_t *stm, char *data, unsigned size )
+unsigned priv_stm_take( stm_t *stm, char *data, unsigned size, lck_t lck )
 /* -------------------------------------------------------------------------- */
 {
 	if (stm->count > 0)
-		return priv_stm_getUpdate(stm, data, size);
+		return priv_stm_getUpdate(stm, data, size, lck);
 
 	return E_TIMEOUT;
 }
@@ -231,7 +247,7 @@ unsigned stm_take( stm_t *stm, void *data, unsigned size )
 
 	sys_lock();
 	{
-		len = priv_stm_take(stm, data, size);
+		len = priv_stm_take(stm, data, size, core_lck_saved());
 	}
 	sys_unlock();
 
@@ -253,7 +269,7 @@ unsigned stm_waitFor( stm_t *stm, void *data, unsigned size, cnt_t delay )
 
 	sys_lock();
 	{
-		len = priv_stm_take(stm, data, size);
+		len = priv_stm_take(stm, data, size, core_lck_saved());
 
 		if (len == E_TIMEOUT)
 		{
@@ -282,7 +298,7 @@ unsigned stm_waitUntil( stm_t *stm, void *data, unsigned size, cnt_t time )
 
 	sys_lock();
 	{
-		len = priv_stm_take(stm, data, size);
+		len = priv_stm_take(stm, data, size, core_lck_saved());
 
 		if (len == E_TIMEOUT)
 		{
@@ -298,12 +314,12 @@ unsigned stm_waitUntil( stm_t *stm, void *data, unsigned size, cnt_t time )
 
 /* -------------------------------------------------------------------------- */
 static
-unsigned priv_stm_give( stm_t *stm, const char *data, unsigned size )
+unsigned priv_stm_give( stm_t *stm, const char *data, unsigned size, lck_t lck )
 /* -------------------------------------------------------------------------- */
 {
 	if (stm->count + size <= stm->limit)
 	{
-		priv_stm_putUpdate(stm, data, size);
+		priv_stm_putUpdate(stm, data, size, lck);
 		return E_SUCCESS;
 	}
 
@@ -327,7 +343,7 @@ unsigned stm_give( stm_t *stm, const void *data, unsigned size )
 
 	sys_lock();
 	{
-		event = priv_stm_give(stm, data, size);
+		event = priv_stm_give(stm, data, size, core_lck_saved());
 	}
 	sys_unlock();
 
@@ -349,7 +365,7 @@ unsigned stm_sendFor( stm_t *stm, const void *data, unsigned size, cnt_t delay )
 
 	sys_lock();
 	{
-		event = priv_stm_give(stm, data, size);
+		event = priv_stm_give(stm, data, size, core_lck_saved());
 
 		if (event == E_TIMEOUT)
 		{
@@ -378,7 +394,7 @@ unsigned stm_sendUntil( stm_t *stm, const void *data, unsigned size, cnt_t time
 
 	sys_lock();
 	{
-		event = priv_stm_give(stm, data, size);
+		event = priv_stm_give(stm, data, size, core_lck_saved());
 
 		if (event == E_TIMEOUT)
 		{
@@ -409,7 +425,7 @@ unsigned stm_push( stm_t *stm, const void *data, unsigned size )
 		if (size <= stm->limit)
 		{
 			priv_stm_skipUpdate(stm, size);
-			priv_stm_putUpdate(stm, data, size);
+			priv_stm_putUpdate(stm, data, size, core_lck_saved());
 			event = E_SUCCESS;
 		}
 		else
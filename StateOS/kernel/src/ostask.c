@@ -40,8 +40,12 @@ void tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, stk_t *stack, unsigned s
 	assert_tsk_context();
 	assert(tsk);
 	assert(state);
+#if OS_BASIC_STACK
+	assert(!stack == !size); // basic task has neither private stack nor its size
+#else
 	assert(stack);
 	assert(size);
+#endif
 
 	sys_lock();
 	{
@@ -54,9 +58,12 @@ void tsk_init( tsk_t *tsk, unsigned prio, fun_t *state, stk_t *stack, unsigned s
 		tsk->state = state;
 		tsk->stack = stack;
 		tsk->size  = size;
+#if OS_CPU_COUNT > 1
+		tsk->cpu   = port_cpu_id();
+#endif
 
-		core_ctx_init(tsk);
-		core_tsk_insert(tsk);
+		if (core_ctx_init(tsk))
+			core_tsk_insert(tsk);
 	}
 	sys_unlock();
 }
@@ -69,12 +76,14 @@ tsk_t *wrk_create( unsigned prio, fun_t *state, unsigned size )
 
 	assert_tsk_context();
 	assert(state);
+#if OS_BASIC_STACK == 0
 	assert(size);
+#endif
 
 	sys_lock();
 	{
 		tsk = sys_alloc(SEG_OVER(sizeof(tsk_t)) + size);
-		tsk_init(tsk, prio, state, (void *)((size_t)tsk + SEG_OVER(sizeof(tsk_t))), size);
+		tsk_init(tsk, prio, state, size ? (void *)((size_t)tsk + SEG_OVER(sizeof(tsk_t))) : 0, size);
 		tsk->hdr.obj.res = tsk;
 	}
 	sys_unlock();
@@ -90,12 +99,14 @@ tsk_t *wrk_detached( unsigned prio, fun_t *state, unsigned size )
 
 	assert_tsk_context();
 	assert(state);
+#if OS_BASIC_STACK == 0
 	assert(size);
+#endif
 
 	sys_lock();
 	{
 		tsk = sys_alloc(SEG_OVER(sizeof(tsk_t)) + size);
-		tsk_init(tsk, prio, state, (void *)((size_t)tsk + SEG_OVER(sizeof(tsk_t))), size);
+		tsk_init(tsk, prio, state, size ? (void *)((size_t)tsk + SEG_OVER(sizeof(tsk_t))) : 0, size);
 		tsk->hdr.obj.res = tsk;
 		tsk->join = DETACHED;
 	}
@@ -117,8 +128,11 @@ void tsk_start( tsk_t *tsk )
 	{
 		if (tsk->hdr.id == ID_STOPPED)  // active tasks cannot be started
 		{
-			core_ctx_init(tsk);
-			core_tsk_insert(tsk);
+#if OS_EDF_PRIO
+			tsk->deadline = core_sys_time();
+#endif
+			if (core_ctx_init(tsk)) // basic task without memory for the shared stack remains stopped
+				core_tsk_insert(tsk);
 		}
 	}
 	sys_unlock();
@@ -139,8 +153,11 @@ void tsk_startFrom( tsk_t *tsk, fun_t *state )
 		{
 			tsk->state = state;
 
-			core_ctx_init(tsk);
-			core_tsk_insert(tsk);
+#if OS_EDF_PRIO
+			tsk->deadline = core_sys_time();
+#endif
+			if (core_ctx_init(tsk)) // basic task without memory for the shared stack remains stopped
+				core_tsk_insert(tsk);
 		}
 	}
 	sys_unlock();
@@ -217,8 +234,6 @@ void priv_mtx_remove( tsk_t *tsk )
 	mtx_t *mtx;
 	mtx_t *nxt;
 
-	tsk->mtx.tree = 0;
-
 	for (mtx = tsk->mtx.list; mtx; mtx = nxt)
 	{
 		nxt = mtx->list;
@@ -249,9 +264,15 @@ void priv_tsk_destructor( void )
 /* -------------------------------------------------------------------------- */
 {
 	tsk_t *tsk;
+	hld_t  hld;
 
 	sys_lock();
 	{
+#if OS_ISR_LOCKFREE
+		core_pnd_flush();
+#endif
+		core_hld_init(&hld, LCK_DESTROY, core_lck_saved());
+
 		while (System.des)
 		{
 			tsk = System.des;
@@ -262,9 +283,14 @@ void priv_tsk_destructor( void )
 			}
 			priv_tsk_remove(tsk);
 			core_res_free(&tsk->hdr.obj.res);
+
+			if (core_hld_tick(&hld))
+				core_hld_window(&hld);
 		}
 
 		IDLE.state = core_tsk_idle;
+
+		core_hld_done(&hld);
 	}
 	sys_unlock();
 }
@@ -301,6 +327,9 @@ void tsk_kill( tsk_t *tsk )
 
 	sys_lock();
 	{
+#if OS_ISR_LOCKFREE
+		core_pnd_flush();
+#endif
 		if (tsk->join != DETACHED)         // detached task cannot be reseted
 		{
 			if (tsk->hdr.id != ID_STOPPED) // inactive task cannot be removed
@@ -382,7 +411,7 @@ void tsk_setPrio( unsigned prio )
 	sys_lock();
 	{
 		System.cur->basic = prio;
-		core_cur_prio(prio);
+		core_cur_prio(0);
 	}
 	sys_unlock();
 }
@@ -404,6 +433,126 @@ unsigned tsk_getPrio( void )
 	return prio;
 }
 
+#if OS_EDF_PRIO
+
+/* -------------------------------------------------------------------------- */
+void tsk_setDeadline( cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+
+	sys_lock();
+	{
+		core_cur_deadline(time);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+cnt_t tsk_getDeadline( void )
+/* -------------------------------------------------------------------------- */
+{
+	cnt_t time;
+
+	assert_tsk_context();
+
+	sys_lock();
+	{
+		time = System.cur->deadline;
+	}
+	sys_unlock();
+
+	return time;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+unsigned tsk_setCPU( tsk_t *tsk, unsigned cpu )
+/* -------------------------------------------------------------------------- */
+{
+	unsigned event = E_FAILURE;
+
+	assert_tsk_context();
+	assert(tsk);
+	assert(tsk->hdr.obj.res!=RELEASED);
+
+	sys_lock();
+	{
+		if (tsk->hdr.id == ID_STOPPED && // active tasks cannot be moved
+		    cpu < OS_CPU_COUNT)
+		{
+#if OS_CPU_COUNT > 1
+			tsk->cpu = cpu;
+#endif
+			event = E_SUCCESS;
+		}
+	}
+	sys_unlock();
+
+	return event;
+}
+
+#if OS_ROBIN
+
+/* -------------------------------------------------------------------------- */
+void tsk_setQuantum( tsk_t *tsk, cnt_t quantum )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(tsk);
+	assert(tsk->hdr.obj.res!=RELEASED);
+
+	sys_lock();
+	{
+		tsk->quantum = quantum;
+	}
+	sys_unlock();
+}
+
+#endif
+
+#if OS_TIMER_SLACK
+
+/* -------------------------------------------------------------------------- */
+void tsk_setSlack( tsk_t *tsk, cnt_t slack )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(tsk);
+	assert(tsk->hdr.obj.res!=RELEASED);
+
+	sys_lock();
+	{
+		tsk->hdr.slack = slack;
+	}
+	sys_unlock();
+}
+
+#endif
+
+#if OS_TASK_RUNTIME
+
+/* -------------------------------------------------------------------------- */
+uint64_t tsk_getRuntime( tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	uint64_t run;
+
+	assert(tsk);
+
+	sys_lock();
+	{
+		core_run_account();
+		run = tsk->runtime;
+	}
+	sys_unlock();
+
+	return run;
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 unsigned tsk_waitFor( unsigned flags, cnt_t delay )
 /* -------------------------------------------------------------------------- */
@@ -415,7 +564,7 @@ unsigned tsk_waitFor( unsigned flags, cnt_t delay )
 	sys_lock();
 	{
 		System.cur->tmp.flg.flags = flags;
-		event = core_tsk_waitFor(&System.wai, delay);
+		event = core_tsk_waitFor(&System.cur->wai, delay);
 	}
 	sys_unlock();
 
@@ -433,13 +582,30 @@ unsigned tsk_waitUntil( unsigned flags, cnt_t time )
 	sys_lock();
 	{
 		System.cur->tmp.flg.flags = flags;
-		event = core_tsk_waitUntil(&System.wai, time);
+		event = core_tsk_waitUntil(&System.cur->wai, time);
 	}
 	sys_unlock();
 
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+static
+unsigned priv_tsk_give( tsk_t *tsk, unsigned flags )
+/* -------------------------------------------------------------------------- */
+{
+	if (tsk->guard != &tsk->wai)
+		return E_FAILURE;
+
+	if (tsk->tmp.flg.flags & flags)
+		flags = tsk->tmp.flg.flags &= ~flags;
+
+	if (tsk->tmp.flg.flags == 0)
+		core_tsk_wakeup(tsk, flags);
+
+	return E_SUCCESS;
+}
+
 /* -------------------------------------------------------------------------- */
 unsigned tsk_give( tsk_t *tsk, unsigned flags )
 /* -------------------------------------------------------------------------- */
@@ -451,24 +617,243 @@ unsigned tsk_give( tsk_t *tsk, unsigned flags )
 
 	sys_lock();
 	{
-		if (tsk->guard == &System.wai)
-		{
-			if (tsk->tmp.flg.flags & flags)
-				flags = tsk->tmp.flg.flags &= ~flags;
+		event = priv_tsk_give(tsk, flags);
+	}
+	sys_unlock();
+
+	return event;
+}
 
-			if (tsk->tmp.flg.flags == 0)
-				core_tsk_wakeup(tsk, flags);
+#if OS_ISR_LOCKFREE
 
+/* -------------------------------------------------------------------------- */
+static
+void priv_tsk_resolve( pnd_t *pnd, unsigned flags )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk = (tsk_t *)((char *)pnd - offsetof(tsk_t, pnd));
+
+	priv_tsk_give(tsk, flags);
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned tsk_giveISR( tsk_t *tsk, unsigned flags )
+/* -------------------------------------------------------------------------- */
+{
+	assert(tsk);
+	assert(tsk->hdr.obj.res!=RELEASED);
+
+	if (flags)
+		core_pnd_set(&tsk->pnd, priv_tsk_resolve, flags);
+
+	return E_SUCCESS;
+}
+
+#endif
+
+#if OS_TSK_NOTIFY
+
+/* -------------------------------------------------------------------------- */
+static
+bool priv_ntf_take( tsk_t *tsk )
+/* -------------------------------------------------------------------------- */
+{
+	uint32_t*val = &tsk->ntf.val[tsk->tmp.ntf.slot];
+	uint32_t bits = *val & tsk->tmp.ntf.bits;
+
+	if (tsk->tmp.ntf.mode & ntfCount)
+	{
+		if (*val == 0)
+			return false;
+
+		tsk->tmp.ntf.value = *val;
+		if ((tsk->tmp.ntf.mode & ntfProtect) == 0)
+			*val -= 1;
+
+		return true;
+	}
+
+	if (bits == 0 || ((tsk->tmp.ntf.mode & ntfAll) && bits != tsk->tmp.ntf.bits))
+		return false;
+
+	tsk->tmp.ntf.value = *val;
+	if ((tsk->tmp.ntf.mode & ntfProtect) == 0)
+		*val &= ~bits;
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned tsk_notifyWaitFor( unsigned slot, uint32_t bits, char mode, uint32_t *value, cnt_t delay )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t  * cur;
+	unsigned event;
+
+	assert_tsk_context();
+	assert(slot < OS_TSK_NOTIFY);
+	assert((mode & ~ntfMASK) == 0);
+
+	sys_lock();
+	{
+		cur = System.cur;
+		cur->tmp.ntf.slot = slot;
+		cur->tmp.ntf.bits = bits;
+		cur->tmp.ntf.mode = mode;
+
+		if (priv_ntf_take(cur))
 			event = E_SUCCESS;
-		}
 		else
-			event = E_FAILURE;
+			event = core_tsk_waitFor(&cur->ntf.wai, delay);
+
+		if (event == E_SUCCESS && value)
+			*value = cur->tmp.ntf.value;
+	}
+	sys_unlock();
+
+	return event;
+}
+
+/* -------------------------------------------------------------------------- */
+unsigned tsk_notifyWaitUntil( unsigned slot, uint32_t bits, char mode, uint32_t *value, cnt_t time )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t  * cur;
+	unsigned event;
+
+	assert_tsk_context();
+	assert(slot < OS_TSK_NOTIFY);
+	assert((mode & ~ntfMASK) == 0);
+
+	sys_lock();
+	{
+		cur = System.cur;
+		cur->tmp.ntf.slot = slot;
+		cur->tmp.ntf.bits = bits;
+		cur->tmp.ntf.mode = mode;
+
+		if (priv_ntf_take(cur))
+			event = E_SUCCESS;
+		else
+			event = core_tsk_waitUntil(&cur->ntf.wai, time);
+
+		if (event == E_SUCCESS && value)
+			*value = cur->tmp.ntf.value;
 	}
 	sys_unlock();
 
 	return event;
 }
 
+/* -------------------------------------------------------------------------- */
+static
+void priv_ntf_release( tsk_t *tsk, unsigned slot )
+/* -------------------------------------------------------------------------- */
+{
+//	the waiting task is the only one in its private queue, so it is released without any queue walk
+	if (tsk->guard == &tsk->ntf.wai && tsk->tmp.ntf.slot == slot && priv_ntf_take(tsk))
+		core_tsk_wakeup(tsk, E_SUCCESS);
+}
+
+/* -------------------------------------------------------------------------- */
+uint32_t tsk_notify( tsk_t *tsk, unsigned slot, uint32_t value, unsigned action )
+/* -------------------------------------------------------------------------- */
+{
+	uint32_t *val;
+
+	assert(tsk);
+	assert(tsk->hdr.obj.res!=RELEASED);
+	assert(slot < OS_TSK_NOTIFY);
+	assert(action <= ntfOverwrite);
+
+	sys_lock();
+	{
+		val = &tsk->ntf.val[slot];
+
+		switch (action)
+		{
+		case ntfIncrement: *val += 1;     break;
+		case ntfOverwrite: *val  = value; break;
+		default:           *val |= value; break;
+		}
+
+		priv_ntf_release(tsk, slot);
+
+		value = *val;
+	}
+	sys_unlock();
+
+	return value;
+}
+
+#if OS_ISR_LOCKFREE
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_ntf_resolve( pnd_t *pnd, unsigned slots )
+/* -------------------------------------------------------------------------- */
+{
+	tsk_t *tsk = (tsk_t *)((char *)pnd - offsetof(tsk_t, ntf.pnd));
+	unsigned slot;
+
+	for (slot = 0; slots; slot++, slots >>= 1)
+	{
+		if ((slots & 1) == 0)
+			continue;
+
+		tsk->ntf.val[slot] |= port_atm_swap(&tsk->ntf.set[slot], 0);
+		tsk->ntf.val[slot] += port_atm_swap(&tsk->ntf.inc[slot], 0);
+
+		priv_ntf_release(tsk, slot);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+uint32_t tsk_notifyISR( tsk_t *tsk, unsigned slot, uint32_t value, unsigned action )
+/* -------------------------------------------------------------------------- */
+{
+	assert(tsk);
+	assert(tsk->hdr.obj.res!=RELEASED);
+	assert(slot < OS_TSK_NOTIFY);
+	assert(action <= ntfOverwrite);
+
+	if (action == ntfOverwrite) // the overwritten value cannot be merged with the other posts
+		return tsk_notify(tsk, slot, value, action);
+
+	if (action == ntfIncrement)
+		port_atm_add(&tsk->ntf.inc[slot], 1);
+	else
+		port_atm_or(&tsk->ntf.set[slot], value);
+
+	core_pnd_set(&tsk->ntf.pnd, priv_ntf_resolve, 1U << slot);
+
+	return tsk->ntf.val[slot];
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+uint32_t tsk_notifyClear( tsk_t *tsk, unsigned slot, uint32_t bits )
+/* -------------------------------------------------------------------------- */
+{
+	uint32_t value;
+
+	assert(tsk);
+	assert(tsk->hdr.obj.res!=RELEASED);
+	assert(slot < OS_TSK_NOTIFY);
+
+	sys_lock();
+	{
+		value = tsk->ntf.val[slot];
+		tsk->ntf.val[slot] &= ~bits;
+	}
+	sys_unlock();
+
+	return value;
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 void tsk_sleepFor( cnt_t delay )
 /* -------------------------------------------------------------------------- */
@@ -486,6 +871,9 @@ void tsk_sleepNext( cnt_t delay )
 {
 	sys_lock();
 	{
+#if OS_EDF_PRIO
+		System.cur->deadline = System.cur->start + delay + delay;
+#endif
 		core_tsk_waitNext(&System.dly, delay);
 	}
 	sys_unlock();
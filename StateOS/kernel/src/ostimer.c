@@ -30,9 +30,68 @@
  ******************************************************************************/
 
 #include "inc/ostimer.h"
+#include "inc/ostask.h"
 #include "inc/oscriticalsection.h"
 #include "osalloc.h"
 
+#if OS_TIMER_DAEMON
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_tmr_daemon( void )
+/* -------------------------------------------------------------------------- */
+{
+	tmr_t *tmr;
+	fun_t *state;
+
+	sys_lock();
+	{
+		while (DAEMON.head == 0)
+			core_tsk_waitFor(&DAEMON.queue, INFINITE);
+
+		tmr = DAEMON.head;
+		if (--tmr->dmn.count == 0)
+			DAEMON.head = tmr->dmn.next;
+
+		state = tmr->state;
+		DAEMON.cur = tmr;
+	}
+	sys_unlock();
+
+	if (state)
+		state();
+
+	DAEMON.cur = 0;
+}
+
+static_TSK(timer_daemon, OS_TIMER_DAEMON, priv_tmr_daemon);
+
+/* -------------------------------------------------------------------------- */
+static
+void priv_tmr_cancel( tmr_t *tmr )
+/* -------------------------------------------------------------------------- */
+{
+	tmr_t **que = &DAEMON.head;
+	tmr_t  *prv = 0;
+
+	if (tmr->dmn.count == 0)
+		return;
+
+	while (*que != tmr)
+	{
+		prv = *que;
+		que = &prv->dmn.next;
+	}
+
+	*que = tmr->dmn.next;
+	if (DAEMON.tail == tmr)
+		DAEMON.tail = prv;
+
+	tmr->dmn.count = 0;
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 void tmr_init( tmr_t *tmr, fun_t *state )
 /* -------------------------------------------------------------------------- */
@@ -82,9 +141,12 @@ void tmr_kill( tmr_t *tmr )
 	{
 		if (tmr->hdr.id == ID_TIMER)
 		{
-			core_all_wakeup(tmr->hdr.obj.queue, E_STOPPED);
+			core_all_wakeup(tmr->hdr.obj.queue, E_STOPPED, core_lck_saved());
 			core_tmr_remove(tmr);
 		}
+#if OS_TIMER_DAEMON
+		priv_tmr_cancel(tmr);
+#endif
 	}
 	sys_unlock();
 }
@@ -290,4 +352,45 @@ unsigned tmr_waitUntil( tmr_t *tmr, cnt_t time )
 	return event;
 }
 
+#if OS_TIMER_DAEMON
+
+/* -------------------------------------------------------------------------- */
+void tmr_setDeferred( tmr_t *tmr, bool deferred )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(tmr);
+	assert(tmr->hdr.obj.res!=RELEASED);
+
+	sys_lock();
+	{
+		tmr->dmn.on = deferred;
+
+		if (deferred && timer_daemon->hdr.id == ID_STOPPED)
+			tsk_start(timer_daemon);
+	}
+	sys_unlock();
+}
+
+#endif
+
+#if OS_TIMER_SLACK
+
+/* -------------------------------------------------------------------------- */
+void tmr_setSlack( tmr_t *tmr, cnt_t slack )
+/* -------------------------------------------------------------------------- */
+{
+	assert_tsk_context();
+	assert(tmr);
+	assert(tmr->hdr.obj.res!=RELEASED);
+
+	sys_lock();
+	{
+		tmr->hdr.slack = slack;
+	}
+	sys_unlock();
+}
+
+#endif
+
 /* -------------------------------------------------------------------------- */
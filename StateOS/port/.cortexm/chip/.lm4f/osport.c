@@ -136,6 +136,22 @@ void port_sys_init( void )
 
 #endif//HW_TIMER_SIZE
 
+#if (OS_TASK_RUNTIME || OS_TRACE || OS_TIME_NSEC || OS_LOCK_STATS) && (__CORTEX_M >= 3)
+
+/******************************************************************************
+ Runtime accounting, trace, monotonic clock and lock statistics: configuration of the processor cycle counter
+*******************************************************************************/
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0U;
+	DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#endif
+
 /******************************************************************************
  Configuration of interrupt for context switch
 *******************************************************************************/
@@ -158,6 +174,10 @@ void port_sys_init( void )
 void SysTick_Handler( void )
 {
 	SysTick->CTRL;
+	#if OS_DYNAMIC_TICK
+	if (port_tck_handler()) // the suppressed period has elapsed
+		return;
+	#endif
 	core_sys_tick();
 }
 
@@ -66,6 +66,16 @@ extern "C" {
 
 /* -------------------------------------------------------------------------- */
 
+#if     OS_CPU_COUNT > 1
+#error  osconfig.h: Incorrect OS_CPU_COUNT value! Only 1 is allowed for this port.
+#endif
+
+#if     OS_VIRTUAL_TIME
+#error  osconfig.h: Incorrect OS_VIRTUAL_TIME value! Virtual time is not available for this port.
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 #ifndef OS_MAIN_PRIO
 #define OS_MAIN_PRIO          0 /* priority of main process                   */
 #endif
@@ -204,6 +214,85 @@ void * port_get_sp( void )
 
 #define port_set_barrier()  __ISB()
 
+/* -------------------------------------------------------------------------- */
+// wait for interrupt with the interrupts masked
+// the pending interrupt wakes the processor and is served after unmasking
+// interrupts masked with BASEPRI do not wake the processor, so PRIMASK is used for the time of waiting
+
+#if OS_LOCK_LEVEL && (__CORTEX_M >= 3)
+
+__STATIC_INLINE
+void port_cpu_sleep( void )
+{
+	__disable_irq();
+	port_clr_lock();
+	__WFI();
+	port_set_lock();
+	__enable_irq();
+}
+
+#else
+
+#define port_cpu_sleep()    __WFI()
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// dynamic tick of the SysTick timer, common to all chip ports (.cortexm/osport.c)
+// port_tck_suspend: suppress the system timer interrupts for at most 'ticks' ticks
+//                   return true if the interrupts have been suppressed
+// port_tck_resume:  restore the system timer interrupts, return number of ticks elapsed since the suppression
+// port_tck_handler: called at the beginning of SysTick_Handler
+//                   return true if the interrupt has ended the suppressed period (then the ticks are counted by core_sys_resume)
+
+#if HW_TIMER_SIZE == 0 && OS_DYNAMIC_TICK
+
+bool     port_tck_suspend( uint64_t ticks );
+uint32_t port_tck_resume( void );
+bool     port_tck_handler( void );
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// return current value of the runtime counter (processor cycles)
+// the cycle counter is started in port_sys_init
+
+#if (OS_TASK_RUNTIME || OS_TRACE || OS_TIME_NSEC || OS_LOCK_STATS) && (__CORTEX_M >= 3)
+#define port_run_time()     (DWT->CYCCNT)
+#endif
+
+/* -------------------------------------------------------------------------- */
+// tick-less mode with preemption: set the time slice of the next task (in ticks of the system timer)
+// reload value of the SysTick is reprogrammed; the clock source is the same as selected in port_sys_init
+// too long time slices are limited to the range of the SysTick counter
+
+#if HW_TIMER_SIZE && OS_ROBIN
+
+#if   (CPU_FREQUENCY)/(OS_ROBIN)-1 <= SysTick_LOAD_RELOAD_Msk
+#define ST_SLICE_TICK      ((CPU_FREQUENCY)/(OS_FREQUENCY))
+#elif defined(ST_FREQUENCY)
+#define ST_SLICE_TICK      ((ST_FREQUENCY)/(OS_FREQUENCY))
+#else
+#define ST_SLICE_TICK        0
+#endif
+
+#if ST_SLICE_TICK > 0
+
+#define port_ctx_slice      port_ctx_slice
+
+__STATIC_INLINE
+void port_ctx_slice( cnt_t slice )
+{
+	const uint32_t max = (SysTick_LOAD_RELOAD_Msk + 1) / (ST_SLICE_TICK);
+
+	SysTick->LOAD = (slice < max ? (uint32_t) slice : max) * (ST_SLICE_TICK) - 1;
+	SysTick->VAL  = 0;
+}
+
+#endif
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 #if __CORTEX_M > 0
@@ -226,6 +315,108 @@ void port_spn_lock( volatile unsigned *lock )
 
 #endif//__CORTEX_M
 
+/* -------------------------------------------------------------------------- */
+// atomic operations of the lock-free kernel queues
+// port_atm_add, port_atm_or and port_atm_swap return the previous value of the word
+// Cortex-M0 has no exclusive access instructions, so there the operation is executed with the interrupts disabled
+
+#if __CORTEX_M > 0
+
+__STATIC_INLINE
+unsigned port_atm_add( volatile unsigned *ptr, unsigned val )
+{
+	unsigned prv;
+	__DMB();
+	do prv = __LDREXW((volatile uint32_t *)ptr);
+	while (__STREXW(prv + val, (volatile uint32_t *)ptr));
+	__DMB();
+	return prv;
+}
+
+__STATIC_INLINE
+unsigned port_atm_or( volatile unsigned *ptr, unsigned val )
+{
+	unsigned prv;
+	__DMB();
+	do prv = __LDREXW((volatile uint32_t *)ptr);
+	while (__STREXW(prv | val, (volatile uint32_t *)ptr));
+	__DMB();
+	return prv;
+}
+
+__STATIC_INLINE
+unsigned port_atm_swap( volatile unsigned *ptr, unsigned val )
+{
+	unsigned prv;
+	__DMB();
+	do prv = __LDREXW((volatile uint32_t *)ptr);
+	while (__STREXW(val, (volatile uint32_t *)ptr));
+	__DMB();
+	return prv;
+}
+
+__STATIC_INLINE
+bool port_atm_cas( void * volatile *ptr, void *cmp, void *val )
+{
+	__DMB();
+	do if ((uintptr_t)__LDREXW((volatile uint32_t *)ptr) != (uintptr_t)cmp) { __CLREX(); return false; }
+	while (__STREXW((uint32_t)(uintptr_t)val, (volatile uint32_t *)ptr));
+	__DMB();
+	return true;
+}
+
+#else
+
+__STATIC_INLINE
+unsigned port_atm_add( volatile unsigned *ptr, unsigned val )
+{
+	unsigned prv;
+	lck_t lck = port_get_lock();
+	port_set_lock();
+	prv = *ptr;
+	*ptr = prv + val;
+	port_put_lock(lck);
+	return prv;
+}
+
+__STATIC_INLINE
+unsigned port_atm_or( volatile unsigned *ptr, unsigned val )
+{
+	unsigned prv;
+	lck_t lck = port_get_lock();
+	port_set_lock();
+	prv = *ptr;
+	*ptr = prv | val;
+	port_put_lock(lck);
+	return prv;
+}
+
+__STATIC_INLINE
+unsigned port_atm_swap( volatile unsigned *ptr, unsigned val )
+{
+	unsigned prv;
+	lck_t lck = port_get_lock();
+	port_set_lock();
+	prv = *ptr;
+	*ptr = val;
+	port_put_lock(lck);
+	return prv;
+}
+
+__STATIC_INLINE
+bool port_atm_cas( void * volatile *ptr, void *cmp, void *val )
+{
+	bool res;
+	lck_t lck = port_get_lock();
+	port_set_lock();
+	res = (*ptr == cmp);
+	if (res) *ptr = val;
+	port_put_lock(lck);
+	return res;
+}
+
+#endif//__CORTEX_M
+
 /* -------------------------------------------------------------------------- */
 
 #ifdef __cplusplus
@@ -0,0 +1,167 @@
+/******************************************************************************
+
+    @file    StateOS: osport.c
+    @author  Rajmund Szymanski
+    @date    17.10.2026
+    @brief   StateOS port file for ARM Cotrex-M uC.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#include "oskernel.h"
+
+/* -------------------------------------------------------------------------- */
+
+#if HW_TIMER_SIZE == 0 && OS_DYNAMIC_TICK
+
+static  uint32_t TCK_PER = 0;     // SysTick counts per system timer tick
+static  uint32_t TCK_OFS = 0;     // SysTick counts of the current tick elapsed before the suppression
+static  uint32_t TCK_LEN = 0;     // SysTick counts of the suppressed period
+static  uint32_t TCK_CNT = 0;     // number of ticks of the suppressed period; 0 if not suppressed
+static  bool     TCK_END = false; // the suppressed period has elapsed
+static  bool     TCK_FIX = false; // the periodic reload value has to be restored
+
+/******************************************************************************
+ Non-tick-less mode with dynamic tick: beginning of the interrupt handler of system timer
+ Return true if the suppressed period has elapsed; the ticks are counted by core_sys_resume
+*******************************************************************************/
+
+bool port_tck_handler( void )
+{
+	if (TCK_FIX) // the first tick after the suppression has elapsed
+	{
+		TCK_FIX = false;
+		SysTick->LOAD = TCK_PER - 1U;
+		SysTick->VAL  = 0U;
+	}
+	if (TCK_CNT) // the suppressed period has elapsed
+	{
+		TCK_END = true;
+		core_sys_resume(0);
+		return true;
+	}
+	return false;
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+/******************************************************************************
+ Non-tick-less mode with dynamic tick: suppress the system timer interrupts
+ SysTick counts the rest of the current tick and the following ticks as a single period
+ Longer periods than the SysTick range are chained by the idle process
+*******************************************************************************/
+
+bool port_tck_suspend( uint64_t ticks )
+{
+	uint32_t per = SysTick->LOAD + 1U;
+	uint32_t max = (SysTick_LOAD_RELOAD_Msk + 1U) / per;
+	uint32_t val;
+
+	if (TCK_CNT || TCK_FIX)
+		return false;
+
+	if (ticks > max)
+		ticks = max;
+
+	if (ticks < 2)
+		return false;
+
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	val = SysTick->VAL;
+
+	if (val == 0U || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+	{
+		SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+		return false; // the tick is pending
+	}
+
+	TCK_PER = per;
+	TCK_OFS = per - val;
+	TCK_LEN = val + ((uint32_t)ticks - 1U) * per;
+	TCK_CNT = (uint32_t)ticks;
+
+	SysTick->LOAD = TCK_LEN - 1U;
+	SysTick->VAL  = 0U;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	return true;
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+/******************************************************************************
+ Non-tick-less mode with dynamic tick: restore the system timer interrupts
+ The rest of the current tick is counted as a single period, then the periodic reload is restored
+*******************************************************************************/
+
+uint32_t port_tck_resume( void )
+{
+	uint32_t tot, rem;
+	uint32_t cnt;
+
+	if (TCK_CNT == 0U)
+		return 0U;
+
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+	if (TCK_END || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+	{
+		SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk; // the ticks are counted here
+		tot = TCK_OFS + TCK_LEN;
+	}
+	else
+	{
+		tot = TCK_OFS + TCK_LEN - SysTick->VAL;
+	}
+
+	cnt = tot / TCK_PER;
+	rem = TCK_PER - tot % TCK_PER;
+	if (rem < 2U)
+	{
+		rem = TCK_PER;
+		cnt++;
+	}
+
+	SysTick->LOAD = rem - 1U;
+	SysTick->VAL  = 0U;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	TCK_FIX = (rem != TCK_PER);
+	TCK_END = false;
+	TCK_CNT = 0U;
+
+	return cnt;
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+#endif//HW_TIMER_SIZE == 0 && OS_DYNAMIC_TICK
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,274 @@
+/******************************************************************************
+
+    @file    StateOS: oscore.h
+    @author  Rajmund Szymanski
+    @date    10.10.2018
+    @brief   StateOS port file for POSIX hosted environment.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOSCORE_H
+#define __STATEOSCORE_H
+
+#include "osbase.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_HEAP_SIZE
+#define OS_HEAP_SIZE          0 /* default system heap: all free memory       */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_STACK_SIZE
+#define OS_STACK_SIZE       256 /* default task stack size in bytes           */
+#endif
+
+#ifndef OS_IDLE_STACK
+#define OS_IDLE_STACK       128 /* idle task stack size in bytes              */
+#endif
+
+// each task is executed on its own host stack
+// task's private stack storage holds only the task context
+#ifndef OS_HOST_STACK
+#define OS_HOST_STACK     65536 /* host stack size in bytes                   */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_LOCK_LEVEL
+#define OS_LOCK_LEVEL         0 /* critical section blocks all interrupts     */
+#endif
+
+#if     OS_LOCK_LEVEL
+#error  osconfig.h: Incorrect OS_LOCK_LEVEL value! Only 0 is allowed for this port.
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_MAIN_PRIO
+#define OS_MAIN_PRIO          0 /* priority of main process                   */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef  __cplusplus
+
+#ifndef OS_FUNCTIONAL
+#define OS_FUNCTIONAL         1 /* include c++ functional library header      */
+#endif
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+typedef unsigned              lck_t;
+typedef uint64_t              stk_t;
+
+/* -------------------------------------------------------------------------- */
+// task context
+
+typedef struct __ctx ctx_t;
+
+struct __ctx
+{
+	void   * uc;  // host context with its own host stack, assigned on first use
+	fun_t  * pc;
+};
+
+#define _CTX_INIT( pc ) { 0, pc }
+
+/* -------------------------------------------------------------------------- */
+// init task context
+
+void port_ctx_init( ctx_t *ctx, fun_t *pc );
+
+/* -------------------------------------------------------------------------- */
+// is procedure inside ISR?
+
+__STATIC_INLINE
+bool port_isr_context( void )
+{
+	return (port_isr != 0U);
+}
+
+/* -------------------------------------------------------------------------- */
+// are interrupts masked?
+
+__STATIC_INLINE
+bool port_isr_masked( void )
+{
+	return (port_lck != 0U);
+}
+
+/* -------------------------------------------------------------------------- */
+// get current stack pointer
+// return the context of the current process; it is placed at the top of the task's stack storage
+
+#if OS_CPU_COUNT > 1
+extern  ctx_t             * port_ctx_tab[OS_CPU_COUNT];
+#define port_ctx_cur        port_ctx_tab[port_cpu]
+#else
+extern  ctx_t             * port_ctx_cur;
+#endif
+
+__STATIC_INLINE
+void * port_get_sp( void )
+{
+	return (void *) port_ctx_cur;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#define port_set_barrier()  __atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+/* -------------------------------------------------------------------------- */
+// tick-less mode with preemption: set the time slice of the next task (in ticks of the system timer)
+// the round-robin timer is shared by all processors, so it can be reprogrammed only with a single processor
+
+#if HW_TIMER_SIZE && OS_ROBIN && OS_VIRTUAL_TIME == 0 && OS_CPU_COUNT == 1
+void port_ctx_slice( cnt_t slice );
+#define port_ctx_slice      port_ctx_slice
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef  OS_MULTICORE
+
+#error  OS_MULTICORE is an internal port definition!
+
+#else
+
+#define OS_MULTICORE
+
+// wait until the spin lock object is unlocked
+void port_spn_wait( volatile unsigned *lock );
+
+__STATIC_INLINE
+void port_spn_lock( volatile unsigned *lock )
+{
+	while (__atomic_exchange_n(lock, 1U, __ATOMIC_ACQUIRE))
+		port_spn_wait(lock);
+}
+
+#endif//OS_MULTICORE
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_CPU_COUNT > 1
+
+// system spin lock; the critical section masks interrupts of the current processor
+// and excludes all other processors from the kernel
+
+extern  volatile unsigned   port_sys_lck;
+
+__STATIC_INLINE
+void port_set_lock( void )
+{
+	if (port_lck == 0U)
+	{
+		port_lck = 1U;
+		port_set_barrier();
+		port_spn_lock(&port_sys_lck);
+	}
+}
+
+__STATIC_INLINE
+void port_clr_lock( void )
+{
+	if (port_lck != 0U)
+	{
+		__atomic_store_n(&port_sys_lck, 0U, __ATOMIC_RELEASE);
+		port_set_barrier();
+		port_lck = 0U;
+	}
+
+	if (port_irq != 0U && port_isr == 0U)
+		port_isr_flush();
+}
+
+#else
+
+__STATIC_INLINE
+void port_set_lock( void )
+{
+	port_lck = 1U;
+	port_set_barrier();
+}
+
+__STATIC_INLINE
+void port_clr_lock( void )
+{
+	port_set_barrier();
+	port_lck = 0U;
+
+	if (port_irq != 0U && port_isr == 0U)
+		port_isr_flush();
+}
+
+#endif
+
+#define port_get_lock()     port_lck
+#define port_put_lock(lck)  ((lck) ? port_set_lock() : port_clr_lock())
+
+/* -------------------------------------------------------------------------- */
+// atomic operations of the lock-free kernel queues; they are safe in the signal handlers (interrupts)
+// port_atm_add, port_atm_or and port_atm_swap return the previous value of the word
+
+__STATIC_INLINE
+unsigned port_atm_add( volatile unsigned *ptr, unsigned val )
+{
+	return __atomic_fetch_add(ptr, val, __ATOMIC_SEQ_CST);
+}
+
+__STATIC_INLINE
+unsigned port_atm_or( volatile unsigned *ptr, unsigned val )
+{
+	return __atomic_fetch_or(ptr, val, __ATOMIC_SEQ_CST);
+}
+
+__STATIC_INLINE
+unsigned port_atm_swap( volatile unsigned *ptr, unsigned val )
+{
+	return __atomic_exchange_n(ptr, val, __ATOMIC_SEQ_CST);
+}
+
+__STATIC_INLINE
+bool port_atm_cas( void * volatile *ptr, void *cmp, void *val )
+{
+	return __atomic_compare_exchange_n(ptr, &cmp, val, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//__STATEOSCORE_H
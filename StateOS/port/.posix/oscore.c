@@ -0,0 +1,292 @@
+/******************************************************************************
+
+    @file    StateOS: oscore.c
+    @author  Rajmund Szymanski
+    @date    10.10.2018
+    @brief   StateOS port file for POSIX hosted environment.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+#include <signal.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include "oskernel.h"
+#include "inc/ostask.h"
+
+/* -------------------------------------------------------------------------- */
+// host context
+
+typedef struct __host host_t;
+
+struct __host
+{
+	host_t   * next;  // next host context in the registry
+	ctx_t    * ctx;   // owner of the host context
+	bool       fresh; // host context must be (re)initialized before use
+#if OS_CPU_COUNT > 1
+	volatile
+	unsigned   busy;  // host context is in use by a processor (spin lock)
+#endif
+	ucontext_t uc;    // saved host context
+};
+
+static  host_t   * HOST = 0; // registry of host contexts
+#if OS_CPU_COUNT > 1
+static  host_t     MAIN_HOST = { .busy = 1U };
+#else
+static  host_t     MAIN_HOST;
+#endif
+static  ctx_t      MAIN_CTX = { &MAIN_HOST, 0 };
+
+#if OS_CPU_COUNT > 1
+
+static  volatile
+        unsigned   HOST_LCK = 0U;          // the registry is shared by the processors
+static  host_t     HOST_CPU[OS_CPU_COUNT]; // host threads of the processors
+static  host_t   * HOST_CUR[OS_CPU_COUNT] = { &MAIN_HOST }; // host context in use by the processor
+static  host_t   * HOST_PRV[OS_CPU_COUNT]; // host context to be released after the switch
+
+ctx_t            * port_ctx_tab[OS_CPU_COUNT] = { &MAIN_CTX };
+
+#else
+
+ctx_t            * port_ctx_cur = &MAIN_CTX;
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// return host context assigned to the task context 'ctx'
+// host context and its host stack are allocated only once for each task context
+
+static
+host_t *priv_ctx_host( ctx_t *ctx )
+{
+	host_t *host;
+	char   *base;
+
+#if OS_CPU_COUNT > 1
+	port_spn_lock(&HOST_LCK);
+#endif
+	for (host = HOST; host; host = host->next)
+		if (host->ctx == ctx)
+			break;
+
+	if (host == 0)
+	{
+		base = mmap(0, OS_HOST_STACK, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+		assert(base != MAP_FAILED);
+
+		host = (host_t *)(base + LIMITED(OS_HOST_STACK - sizeof(host_t), stk_t));
+		host->uc.uc_stack.ss_sp   = base;
+		host->uc.uc_stack.ss_size = (size_t)host - (size_t)base;
+		host->ctx  = ctx;
+		host->next = HOST;
+		HOST = host;
+	}
+#if OS_CPU_COUNT > 1
+	__atomic_store_n(&HOST_LCK, 0U, __ATOMIC_RELEASE);
+#endif
+
+	return host;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_CPU_COUNT > 1
+
+// release the host context the processor has just switched from
+
+static
+void priv_ctx_done( void )
+{
+	host_t *prv = HOST_PRV[port_cpu];
+
+	if (prv)
+	{
+		HOST_PRV[port_cpu] = 0;
+		__atomic_store_n(&prv->busy, 0U, __ATOMIC_RELEASE);
+	}
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// the first procedure executed by the task on its host stack
+
+static
+void priv_ctx_start( void )
+{
+#if OS_CPU_COUNT > 1
+	priv_ctx_done();
+#endif
+	port_isr = 0U;
+	port_ctx_cur->pc();
+}
+
+/* -------------------------------------------------------------------------- */
+// prepare host context 'host' to start the task on its host stack
+
+static
+void priv_ctx_make( host_t *host )
+{
+	host->fresh = false;
+	getcontext(&host->uc);
+	sigemptyset(&host->uc.uc_sigmask); // the task may be created inside the signal handler
+#if OS_CPU_COUNT > 1
+	if (port_cpu != 0U) // the system timer interrupts are delivered to the first processor only
+		sigaddset(&host->uc.uc_sigmask, SIGALRM);
+#endif
+	host->uc.uc_link = 0;
+	makecontext(&host->uc, priv_ctx_start, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+// return host context of the task context 'ctx' ready to be restored
+// in the multi-core mode the host context is taken by the current processor
+
+static
+host_t *priv_ctx_load( ctx_t *ctx )
+{
+	if (ctx->uc == 0)
+	{
+		ctx->uc = priv_ctx_host(ctx);
+		((host_t *)ctx->uc)->fresh = true;
+	}
+
+#if OS_CPU_COUNT > 1
+	if (ctx->uc != HOST_CUR[port_cpu])
+	{
+		port_spn_lock(&((host_t *)ctx->uc)->busy);
+		HOST_PRV[port_cpu] = HOST_CUR[port_cpu];
+		HOST_CUR[port_cpu] = ctx->uc;
+	}
+#endif
+
+	if (((host_t *)ctx->uc)->fresh)
+		priv_ctx_make(ctx->uc);
+
+	return ctx->uc;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_ctx_init( ctx_t *ctx, fun_t *pc )
+{
+	host_t *host = priv_ctx_host(ctx);
+
+	host->fresh = true;
+	ctx->uc = host;
+	ctx->pc = pc;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_CPU_COUNT > 1
+
+// assign the host thread of the current processor to its idle process
+
+void port_ctx_idle( void )
+{
+	ctx_t  *ctx  = System.idle->sp;
+	host_t *host = &HOST_CPU[port_cpu];
+
+	host->ctx  = ctx;
+	host->busy = 1U;
+	ctx->uc = host;
+
+	HOST_CUR[port_cpu] = host;
+	port_ctx_cur = ctx;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// interrupt handler for context switch
+
+#if OS_CPU_COUNT > 1
+
+void PendSV_Handler( void )
+{
+	ctx_t  *cur = port_ctx_cur;
+	ctx_t  *nxt = core_tsk_handler(cur);
+	host_t *prv = HOST_CUR[port_cpu];
+
+	if (nxt != cur)
+	{
+		port_ctx_cur = nxt;
+		swapcontext(&prv->uc, &priv_ctx_load(nxt)->uc);
+		priv_ctx_done();
+	}
+	else
+	if (prv->fresh) // the current task has been restarted by another processor
+	{
+		setcontext(&priv_ctx_load(nxt)->uc);
+	}
+}
+
+#else
+
+void PendSV_Handler( void )
+{
+	ctx_t *cur = port_ctx_cur;
+	ctx_t *nxt = core_tsk_handler(cur);
+
+	if (nxt != cur)
+	{
+		port_ctx_cur = nxt;
+		swapcontext(&((host_t *)cur->uc)->uc, &priv_ctx_load(nxt)->uc);
+	}
+	else
+	if (((host_t *)cur->uc)->fresh) // the current context has been restarted (basic task on the shared stack)
+	{
+		setcontext(&priv_ctx_load(nxt)->uc);
+	}
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// the task's private stack storage is unused; restart the task on its own host stack
+
+void core_tsk_flip( void *sp )
+{
+	ctx_t  *ctx  = port_ctx_cur;
+	host_t *host = ctx->uc;
+
+	(void) sp;
+
+	if (host == &MAIN_HOST)
+		ctx->uc = host = priv_ctx_host(ctx);
+
+	host->fresh = true;
+	ctx->pc = core_tsk_loop;
+
+	setcontext(&priv_ctx_load(ctx)->uc);
+
+	for (;;);
+}
+
+/* -------------------------------------------------------------------------- */
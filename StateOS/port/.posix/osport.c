@@ -0,0 +1,692 @@
+/******************************************************************************
+
+    @file    StateOS: osport.c
+    @author  Rajmund Szymanski
+    @date    10.10.2018
+    @brief   StateOS port file for POSIX hosted environment.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include "oskernel.h"
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_CPU_COUNT > 1
+
+__thread unsigned port_cpu = 0U;
+cpu_t             port_cpu_tab[OS_CPU_COUNT];
+volatile unsigned port_sys_lck = 0U;
+
+static  pthread_t CPU[OS_CPU_COUNT]; // host threads of the processors
+
+#else
+
+volatile unsigned port_lck = 0U;
+volatile unsigned port_isr = 0U;
+volatile unsigned port_irq = 0U;
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#define NSEC 1000000000ULL
+
+static  struct timespec BASE; // start time of the system timer
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_VIRTUAL_TIME == 0
+
+// return host monotonic clock value (in ns) since the start of the system timer
+
+static
+uint64_t priv_sys_nsec( void )
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)(ts.tv_sec - BASE.tv_sec) * NSEC + (uint64_t)ts.tv_nsec - (uint64_t)BASE.tv_nsec;
+}
+
+/* -------------------------------------------------------------------------- */
+// return number of system timer ticks since the start of the system timer
+
+static
+uint64_t priv_sys_tick( void )
+{
+	uint64_t ns = priv_sys_nsec();
+
+	return ns / NSEC * (OS_FREQUENCY) + ns % NSEC * (OS_FREQUENCY) / NSEC;
+}
+
+/* -------------------------------------------------------------------------- */
+// return current value of the runtime counter (host monotonic clock in ns)
+
+#if OS_TASK_RUNTIME || OS_TRACE || OS_TIME_NSEC || OS_LOCK_STATS
+
+uint32_t port_run_nsec( void )
+{
+	return (uint32_t)priv_sys_nsec();
+}
+
+#endif
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if (HW_TIMER_SIZE || OS_DYNAMIC_TICK) && OS_VIRTUAL_TIME == 0
+
+// convert number of system timer ticks to host timespec value (rounded up)
+
+static
+struct timespec priv_sys_spec( uint64_t tck )
+{
+	struct timespec ts;
+	uint64_t ns = tck / (OS_FREQUENCY) * NSEC + (tck % (OS_FREQUENCY) * NSEC + (OS_FREQUENCY) - 1) / (OS_FREQUENCY);
+
+	ns += (uint64_t)BASE.tv_nsec;
+	ts.tv_sec  = BASE.tv_sec + (time_t)(ns / NSEC);
+	ts.tv_nsec = (long)(ns % NSEC);
+
+	return ts;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_VIRTUAL_TIME
+static  uint64_t VTIME = 0; // virtual system timer counter
+#else
+static  timer_t  TMR; // system timer
+#if HW_TIMER_SIZE && OS_ROBIN
+static  timer_t  RBN; // round-robin timer
+#endif
+#endif
+
+/* -------------------------------------------------------------------------- */
+// host signal handler; deliver the interrupt request
+
+static
+void priv_sig_handler( int sig, siginfo_t *info, void *uc )
+{
+	(void) sig;
+	(void) uc;
+
+	port_irq_set((unsigned) info->si_value.sival_int);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_CPU_COUNT > 1
+
+// inter-processor interrupt handler; the interrupt request is already pending
+
+static
+void priv_ipi_handler( int sig )
+{
+	(void) sig;
+
+	if (port_lck == 0U && port_isr == 0U && port_irq != 0U)
+		port_isr_flush();
+}
+
+/* -------------------------------------------------------------------------- */
+// set pending interrupt request of another processor 'cpu' and signal the processor
+
+static
+void priv_cpu_signal( unsigned cpu, unsigned irq )
+{
+	__atomic_fetch_or(&port_cpu_tab[cpu].irq, irq, __ATOMIC_SEQ_CST);
+
+	if (CPU[cpu])
+		pthread_kill(CPU[cpu], PORT_SIG_IPI);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_ctx_idle( void );
+
+// host thread of the processor executes the idle process of the processor
+// the system timer interrupts are delivered to the first processor only
+
+static
+void *priv_cpu_start( void *arg )
+{
+	sigset_t set;
+
+	port_cpu = (unsigned)(uintptr_t) arg;
+	port_ctx_idle();
+
+	CPU[port_cpu] = pthread_self();
+	sigemptyset(&set);
+	sigaddset(&set, PORT_SIG_IPI);
+	pthread_sigmask(SIG_UNBLOCK, &set, 0);
+
+	core_tsk_loop();
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_VIRTUAL_TIME == 0
+
+static
+void priv_tmr_create( timer_t *tmr, unsigned irq )
+{
+	struct sigevent sev = { 0 };
+
+	sev.sigev_notify = SIGEV_SIGNAL;
+	sev.sigev_signo  = SIGALRM;
+	sev.sigev_value.sival_int = (int) irq;
+
+	timer_create(CLOCK_MONOTONIC, &sev, tmr);
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+void port_sys_init( void )
+{
+	struct sigaction sa = { 0 };
+	#if OS_VIRTUAL_TIME == 0 && (HW_TIMER_SIZE == 0 || OS_ROBIN)
+	struct itimerspec it = { { 0, 0 }, { 0, 0 } };
+	#endif
+
+/******************************************************************************
+ Make sure that the system timer has not yet been initialized
+ This is only needed for compilers supporting the "constructor" function attribute or its equivalent
+*******************************************************************************/
+
+	if (BASE.tv_sec || BASE.tv_nsec) return;
+
+/******************************************************************************
+ End of check
+*******************************************************************************/
+
+	clock_gettime(CLOCK_MONOTONIC, &BASE);
+
+/******************************************************************************
+ Configuration of host signal used as interrupt request
+ Signal handler must be reentrant; nested requests are deferred by software
+*******************************************************************************/
+
+	sa.sa_sigaction = priv_sig_handler;
+	sa.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGALRM, &sa, 0);
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#if OS_CPU_COUNT > 1
+
+/******************************************************************************
+ Multi-core mode: configuration of inter-processor interrupt
+ and start of the host threads of the other processors, with the system timer signal blocked
+*******************************************************************************/
+
+	{
+		sigset_t  set, old;
+		pthread_t thd;
+		uintptr_t cpu;
+
+		sa.sa_handler = priv_ipi_handler;
+		sa.sa_flags = SA_RESTART;
+		sigaction(PORT_SIG_IPI, &sa, 0);
+
+		CPU[0] = pthread_self();
+
+		sigemptyset(&set);
+		sigaddset(&set, SIGALRM);
+		sigaddset(&set, PORT_SIG_IPI);
+		pthread_sigmask(SIG_BLOCK, &set, &old);
+		for (cpu = 1; cpu < OS_CPU_COUNT; cpu++)
+			pthread_create(&thd, 0, priv_cpu_start, (void *) cpu);
+		pthread_sigmask(SIG_SETMASK, &old, 0);
+	}
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#endif//OS_CPU_COUNT
+
+#if OS_VIRTUAL_TIME
+
+/******************************************************************************
+ Virtual time mode: the host timers are not used
+ Time breakpoints are reached by the idle process (see port_cpu_wait)
+ Round-robin preemption is not available, tasks of the same priority switch cooperatively
+*******************************************************************************/
+
+#else //OS_VIRTUAL_TIME
+
+	priv_tmr_create(&TMR, PORT_IRQ_TMR);
+
+#if HW_TIMER_SIZE == 0
+
+/******************************************************************************
+ Non-tick-less mode: configuration of system timer
+ It must generate interrupts with frequency OS_FREQUENCY
+*******************************************************************************/
+
+	it.it_value.tv_nsec = it.it_interval.tv_nsec = (long)(NSEC / (OS_FREQUENCY));
+	it.it_value.tv_sec  = it.it_interval.tv_sec  = (time_t)((OS_FREQUENCY) == 1);
+	if ((OS_FREQUENCY) == 1) it.it_value.tv_nsec = it.it_interval.tv_nsec = 0;
+	timer_settime(TMR, 0, &it, 0);
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+#else //HW_TIMER_SIZE
+
+	#if OS_ROBIN
+
+/******************************************************************************
+ Tick-less mode with preemption: configuration of timer for context switch triggering
+ It must generate interrupts with frequency OS_ROBIN
+*******************************************************************************/
+
+	priv_tmr_create(&RBN, PORT_IRQ_RBN);
+	it.it_value.tv_nsec = it.it_interval.tv_nsec = (long)(NSEC / (OS_ROBIN));
+	it.it_value.tv_sec  = it.it_interval.tv_sec  = (time_t)((OS_ROBIN) == 1);
+	if ((OS_ROBIN) == 1) it.it_value.tv_nsec = it.it_interval.tv_nsec = 0;
+	timer_settime(RBN, 0, &it, 0);
+
+/******************************************************************************
+ End of configuration
+*******************************************************************************/
+
+	#endif//OS_ROBIN
+
+#endif//HW_TIMER_SIZE
+
+#endif//OS_VIRTUAL_TIME
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if HW_TIMER_SIZE == 0
+
+/******************************************************************************
+ Non-tick-less mode: interrupt handler of system timer
+ Ticks lost while the interrupts were masked are recovered from the host clock
+*******************************************************************************/
+
+static  uint64_t TCK = 0; // number of served system timer ticks
+#if OS_DYNAMIC_TICK
+static  bool     TCK_SUSPENDED = false;
+#endif
+
+static
+void SysTick_Handler( void )
+{
+#if OS_DYNAMIC_TICK
+	if (TCK_SUSPENDED) // the suppressed period has elapsed
+	{
+		core_sys_resume(0);
+		return;
+	}
+#endif
+	while (TCK < priv_sys_tick())
+	{
+		TCK++;
+		core_sys_tick();
+	}
+}
+
+/******************************************************************************
+ End of the handler
+*******************************************************************************/
+
+	#if OS_DYNAMIC_TICK
+
+/******************************************************************************
+ Non-tick-less mode with dynamic tick: suppress the system timer interrupts
+ The system timer is set to a single interrupt at the end of the suppressed period
+ Longer periods are chained by the idle process
+*******************************************************************************/
+
+bool port_tck_suspend( uint64_t ticks )
+{
+	struct itimerspec it = { { 0, 0 }, { 0, 0 } };
+
+	if (TCK_SUSPENDED)
+		return false;
+
+	if (ticks > (uint64_t)(OS_FREQUENCY) * 3600)
+		ticks = (uint64_t)(OS_FREQUENCY) * 3600;
+
+	TCK_SUSPENDED = true;
+	it.it_value = priv_sys_spec(TCK + ticks);
+	timer_settime(TMR, TIMER_ABSTIME, &it, 0);
+
+	return true;
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+/******************************************************************************
+ Non-tick-less mode with dynamic tick: restore the system timer interrupts
+ Ticks elapsed in the suppressed period are taken from the host clock
+*******************************************************************************/
+
+uint64_t port_tck_resume( void )
+{
+	struct itimerspec it = { { 0, 0 }, { 0, 0 } };
+	uint64_t cnt;
+
+	if (!TCK_SUSPENDED)
+		return 0;
+
+	TCK_SUSPENDED = false;
+	cnt = priv_sys_tick() - TCK;
+	TCK += cnt;
+	it.it_value = priv_sys_spec(TCK + 1);
+	it.it_interval.tv_nsec = (long)(NSEC / (OS_FREQUENCY));
+	it.it_interval.tv_sec  = (time_t)((OS_FREQUENCY) == 1);
+	if ((OS_FREQUENCY) == 1) it.it_interval.tv_nsec = 0;
+	timer_settime(TMR, TIMER_ABSTIME, &it, 0);
+
+	return cnt;
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+	#endif//OS_DYNAMIC_TICK
+
+#else //HW_TIMER_SIZE
+
+/******************************************************************************
+ Tick-less mode: interrupt handler of system timer
+*******************************************************************************/
+
+static  bool     TMR_ARMED = false;
+static  uint64_t TMR_VALUE = 0;
+
+static
+void TIM_IRQHandler( void )
+{
+	TMR_ARMED = false;
+	core_tmr_handler();
+}
+
+/******************************************************************************
+ End of the handler
+*******************************************************************************/
+
+/******************************************************************************
+ Tick-less mode: return current system time
+*******************************************************************************/
+
+uint64_t port_sys_time( void )
+{
+#if OS_VIRTUAL_TIME
+	return VTIME;
+#else
+	return priv_sys_tick();
+#endif
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+/******************************************************************************
+ Tick-less mode: clear time breakpoint
+ The host timer remains armed; spurious interrupt does not affect the system
+*******************************************************************************/
+
+void port_tmr_stop( void )
+{
+#if OS_VIRTUAL_TIME
+	TMR_ARMED = false;
+#endif
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+/******************************************************************************
+ Tick-less mode: set time breakpoint
+*******************************************************************************/
+
+void port_tmr_start( uint64_t timeout )
+{
+#if OS_VIRTUAL_TIME
+	uint64_t tck = VTIME;
+
+	TMR_ARMED = true;
+	TMR_VALUE = tck + (cnt_t)((cnt_t)timeout - (cnt_t)tck);
+#else
+	struct itimerspec it = { { 0, 0 }, { 0, 0 } };
+	uint64_t tck = priv_sys_tick();
+
+	tck += (cnt_t)((cnt_t)timeout - (cnt_t)tck);
+
+	if (TMR_ARMED && TMR_VALUE == tck)
+		return;
+
+	TMR_ARMED = true;
+	TMR_VALUE = tck;
+	it.it_value = priv_sys_spec(tck);
+	timer_settime(TMR, TIMER_ABSTIME, &it, 0);
+#endif
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+	#if OS_ROBIN && OS_VIRTUAL_TIME == 0
+
+/******************************************************************************
+ Tick-less mode with preemption: interrupt handler for context switch triggering
+*******************************************************************************/
+
+static
+void SysTick_Handler( void )
+{
+#if OS_CPU_COUNT > 1
+	unsigned cpu;
+
+	if (port_cpu == 0U) // forward the request to the other processors
+		for (cpu = 1; cpu < OS_CPU_COUNT; cpu++)
+			priv_cpu_signal(cpu, PORT_IRQ_RBN);
+#endif
+	core_ctx_switch();
+}
+
+/******************************************************************************
+ End of the handler
+*******************************************************************************/
+
+/******************************************************************************
+ Tick-less mode with preemption: reset context switch indicator
+*******************************************************************************/
+
+void port_ctx_reset( void )
+{
+	struct itimerspec it;
+
+	timer_gettime(RBN, &it);
+	it.it_value = it.it_interval;
+	timer_settime(RBN, 0, &it, 0);
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+	#if OS_CPU_COUNT == 1
+
+/******************************************************************************
+ Tick-less mode with preemption: set the time slice of the next task
+*******************************************************************************/
+
+void port_ctx_slice( cnt_t slice )
+{
+	struct itimerspec it;
+	uint64_t nsec = (uint64_t) slice * NSEC / (OS_FREQUENCY);
+
+	it.it_interval.tv_sec  = (time_t)(nsec / NSEC);
+	it.it_interval.tv_nsec = (long)(nsec % NSEC);
+	it.it_value = it.it_interval;
+	timer_settime(RBN, 0, &it, 0);
+}
+
+/******************************************************************************
+ End of the function
+*******************************************************************************/
+
+	#endif
+
+	#endif//OS_ROBIN
+
+#endif//HW_TIMER_SIZE
+
+/******************************************************************************
+ Interrupt handler for context switch
+*******************************************************************************/
+
+void PendSV_Handler( void );
+
+/******************************************************************************
+ End of the handler
+*******************************************************************************/
+
+/* -------------------------------------------------------------------------- */
+// virtual interrupt controller: handle all pending interrupt requests
+// the context switch interrupt has the lowest priority
+
+void port_isr_flush( void )
+{
+	unsigned irq;
+
+	do
+	{
+		port_isr = 1U;
+
+		while (irq = __atomic_exchange_n(&port_irq, 0U, __ATOMIC_SEQ_CST), irq)
+		{
+#if HW_TIMER_SIZE == 0
+			if (irq & PORT_IRQ_TMR) SysTick_Handler();
+#else
+			if (irq & PORT_IRQ_TMR) TIM_IRQHandler();
+	#if OS_ROBIN && OS_VIRTUAL_TIME == 0
+			if (irq & PORT_IRQ_RBN) SysTick_Handler();
+	#endif
+#endif
+			if (irq & PORT_IRQ_CTX) PendSV_Handler();
+		}
+
+		port_isr = 0U;
+	}
+	while (port_irq != 0U && port_lck == 0U);
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if OS_CPU_COUNT > 1
+
+void port_cpu_switch( unsigned cpu )
+{
+	if (cpu == port_cpu)
+		port_ctx_switch();
+	else
+		priv_cpu_signal(cpu, PORT_IRQ_CTX);
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// wait until the spin lock object is unlocked
+// the host thread holding the lock may be preempted by the host scheduler
+
+void port_spn_wait( volatile unsigned *lock )
+{
+	unsigned cnt = 0;
+
+	while (__atomic_load_n(lock, __ATOMIC_RELAXED))
+		if (++cnt % 64 == 0)
+			sched_yield();
+}
+
+/* -------------------------------------------------------------------------- */
+// wait for interrupt with the interrupts masked
+// the host signals are blocked until the processor waits, so the interrupt request cannot be missed
+
+void port_cpu_sleep( void )
+{
+	sigset_t set, old;
+
+	sigemptyset(&set);
+	sigaddset(&set, SIGALRM);
+	pthread_sigmask(SIG_BLOCK, &set, &old);
+	if (port_irq == 0U)
+		sigsuspend(&old);
+	pthread_sigmask(SIG_SETMASK, &old, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+// wait for interrupt
+// virtual time mode: the timer interrupt is serviced first to refresh the time breakpoint,
+// then the system timer jumps to the breakpoint; without any breakpoint the host signal is awaited
+
+void port_cpu_wait( void )
+{
+#if OS_VIRTUAL_TIME
+	port_irq_set(PORT_IRQ_TMR);
+
+	if (TMR_ARMED)
+	{
+		if (VTIME < TMR_VALUE)
+			VTIME = TMR_VALUE;
+		port_irq_set(PORT_IRQ_TMR);
+		return;
+	}
+#endif
+	pause();
+}
+
+/* -------------------------------------------------------------------------- */
@@ -0,0 +1,298 @@
+/******************************************************************************
+
+    @file    StateOS: osport.h
+    @author  Rajmund Szymanski
+    @date    10.10.2018
+    @brief   StateOS port definitions for POSIX hosted environment.
+
+ ******************************************************************************
+
+   Copyright (c) 2018 Rajmund Szymanski. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to
+   deal in the Software without restriction, including without limitation the
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+   sell copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+   IN THE SOFTWARE.
+
+ ******************************************************************************/
+
+#ifndef __STATEOSPORT_H
+#define __STATEOSPORT_H
+
+#include <stdint.h>
+#ifndef   NOCONFIG
+#include "osconfig.h"
+#endif
+#include "osdefs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef CPU_FREQUENCY
+#define CPU_FREQUENCY 1000000000 /* Hz; resolution of the host monotonic clock */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_FREQUENCY
+#define OS_FREQUENCY       1000 /* Hz */
+#endif
+
+#if     OS_FREQUENCY > CPU_FREQUENCY
+#error  osconfig.h: Incorrect OS_FREQUENCY value!
+#endif
+
+/* -------------------------------------------------------------------------- */
+// !! WARNING! OS_TIMER_SIZE < HW_TIMER_SIZE may cause unexpected problems !!
+
+#ifndef OS_TIMER_SIZE
+#define OS_TIMER_SIZE        32 /* bit size of system timer counter           */
+#endif
+
+/* -------------------------------------------------------------------------- */
+// virtual time: the system timer is a counter advanced only by the idle process
+// to the nearest time breakpoint, the host clock is not used
+
+#ifndef OS_VIRTUAL_TIME
+#define OS_VIRTUAL_TIME       0 /* system timer follows the host clock        */
+#endif
+
+#if     OS_VIRTUAL_TIME && OS_CPU_COUNT > 1
+#error  osconfig.h: OS_VIRTUAL_TIME requires OS_CPU_COUNT == 1!
+#endif
+
+/* -------------------------------------------------------------------------- */
+// !! WARNING! OS_TIMER_SIZE < HW_TIMER_SIZE may cause unexpected problems !!
+// the host monotonic clock (or the virtual counter) is used as a hardware timer of any size
+
+#ifdef  HW_TIMER_SIZE
+#error  HW_TIMER_SIZE is an internal os definition!
+#elif   OS_VIRTUAL_TIME
+#define HW_TIMER_SIZE OS_TIMER_SIZE /* virtual time works in tick-less mode   */
+#elif   OS_FREQUENCY > 1000
+#define HW_TIMER_SIZE OS_TIMER_SIZE /* bit size of hardware timer             */
+#else
+#define HW_TIMER_SIZE         0 /* os does not work in tick-less mode         */
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#ifndef OS_ROBIN
+#define OS_ROBIN              0 /* system works in cooperative mode           */
+#endif
+
+#if     OS_ROBIN > OS_FREQUENCY
+#error  osconfig.h: Incorrect OS_ROBIN value!
+#endif
+
+/* -------------------------------------------------------------------------- */
+// virtual interrupt controller
+// host signals are delivered as interrupt requests to the current process
+
+#define PORT_IRQ_TMR       0x01 /* system timer interrupt (SysTick / TIM2)    */
+#define PORT_IRQ_RBN       0x02 /* round-robin timer interrupt (tick-less)    */
+#define PORT_IRQ_CTX       0x80 /* context switch interrupt (PendSV)          */
+
+#if OS_CPU_COUNT > 1
+
+// every (virtual) processor is a host thread with its own interrupt controller
+// interrupt requests of other processors are delivered by the host signal PORT_SIG_IPI
+
+#define PORT_SIG_IPI    SIGUSR1 /* inter-processor interrupt signal           */
+
+typedef struct __cpu
+{
+	volatile unsigned lck; // interrupts are masked
+	volatile unsigned isr; // processor is in handler mode
+	volatile unsigned irq; // pending interrupt requests
+
+}	__attribute__((aligned(64))) cpu_t;
+
+extern __thread unsigned port_cpu;                  // index of the current processor
+extern          cpu_t    port_cpu_tab[OS_CPU_COUNT]; // processors' data
+
+#define port_lck            port_cpu_tab[port_cpu].lck
+#define port_isr            port_cpu_tab[port_cpu].isr
+#define port_irq            port_cpu_tab[port_cpu].irq
+
+#else
+
+extern volatile unsigned port_lck; // interrupts are masked
+extern volatile unsigned port_isr; // processor is in handler mode
+extern volatile unsigned port_irq; // pending interrupt requests
+
+#endif
+
+// handle all pending interrupt requests
+void port_isr_flush( void );
+
+/* -------------------------------------------------------------------------- */
+// set pending interrupt request and handle it if interrupts are not masked
+
+__STATIC_INLINE
+void port_irq_set( unsigned irq )
+{
+	__atomic_fetch_or(&port_irq, irq, __ATOMIC_SEQ_CST);
+
+	if (port_lck == 0 && port_isr == 0)
+		port_isr_flush();
+}
+
+/* -------------------------------------------------------------------------- */
+// return index of the current processor
+
+#if OS_CPU_COUNT > 1
+#define port_cpu_id()       port_cpu
+#else
+#define port_cpu_id()       0U
+#endif
+
+/* -------------------------------------------------------------------------- */
+// force yield system control to the next process on the processor 'cpu'
+
+#if OS_CPU_COUNT > 1
+void port_cpu_switch( unsigned cpu );
+#endif
+
+/* -------------------------------------------------------------------------- */
+// wait for interrupt
+
+void port_cpu_wait( void );
+
+#define __WFI()             port_cpu_wait()
+
+/* -------------------------------------------------------------------------- */
+// wait for interrupt with the interrupts masked
+// the pending interrupt request wakes the processor and is handled after unmasking
+
+void port_cpu_sleep( void );
+
+/* -------------------------------------------------------------------------- */
+// return current system time
+
+#if HW_TIMER_SIZE >= OS_TIMER_SIZE
+
+uint64_t port_sys_time( void );
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// return current value of the runtime counter (host monotonic clock in ns)
+// in virtual time mode the system timer is used instead
+
+#if (OS_TASK_RUNTIME || OS_TRACE || OS_TIME_NSEC || OS_LOCK_STATS) && OS_VIRTUAL_TIME == 0
+
+uint32_t port_run_nsec( void );
+
+#define port_run_time()     port_run_nsec()
+
+#define RUN_FREQUENCY    1000000000 /* Hz; frequency of the runtime counter   */
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+// force yield system control to the next process
+
+__STATIC_INLINE
+void port_ctx_switch( void )
+{
+	port_irq_set(PORT_IRQ_CTX);
+}
+
+/* -------------------------------------------------------------------------- */
+// reset context switch indicator
+
+#if HW_TIMER_SIZE && OS_ROBIN && OS_VIRTUAL_TIME == 0
+void port_ctx_reset( void );
+#else
+__STATIC_INLINE
+void port_ctx_reset( void )
+{
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+// clear time breakpoint
+
+#if HW_TIMER_SIZE
+void port_tmr_stop( void );
+#else
+__STATIC_INLINE
+void port_tmr_stop( void )
+{
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+// set time breakpoint
+
+#if HW_TIMER_SIZE
+void port_tmr_start( uint64_t timeout );
+#else
+__STATIC_INLINE
+void port_tmr_start( uint64_t timeout )
+{
+	(void) timeout;
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+// suppress the system timer interrupts for at most 'ticks' ticks (dynamic tick)
+// return true if the interrupts have been suppressed
+
+#if HW_TIMER_SIZE == 0 && OS_DYNAMIC_TICK
+bool port_tck_suspend( uint64_t ticks );
+#endif
+
+/* -------------------------------------------------------------------------- */
+// restore the system timer interrupts, return number of ticks elapsed since the suppression
+
+#if HW_TIMER_SIZE == 0 && OS_DYNAMIC_TICK
+uint64_t port_tck_resume( void );
+#endif
+
+/* -------------------------------------------------------------------------- */
+// force timer interrupt
+
+__STATIC_INLINE
+void port_tmr_force( void )
+{
+#if HW_TIMER_SIZE
+	port_irq_set(PORT_IRQ_TMR);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+// there is no NVIC in the hosted environment
+
+typedef int IRQn_Type;
+
+__STATIC_INLINE void NVIC_EnableIRQ      ( IRQn_Type irq ) { (void) irq; }
+__STATIC_INLINE void NVIC_DisableIRQ     ( IRQn_Type irq ) { (void) irq; }
+__STATIC_INLINE void NVIC_ClearPendingIRQ( IRQn_Type irq ) { (void) irq; }
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__STATEOSPORT_H
@@ -66,6 +66,24 @@ extern "C" {
 
 /* -------------------------------------------------------------------------- */
 
+#if     OS_CPU_COUNT > 1
+#error  osconfig.h: Incorrect OS_CPU_COUNT value! Only 1 is allowed for this port.
+#endif
+
+#if     OS_VIRTUAL_TIME
+#error  osconfig.h: Incorrect OS_VIRTUAL_TIME value! Virtual time is not available for this port.
+#endif
+
+#if     OS_DYNAMIC_TICK
+#error  osconfig.h: Incorrect OS_DYNAMIC_TICK value! Dynamic tick is not available for this port.
+#endif
+
+#if     OS_TASK_RUNTIME
+#error  osconfig.h: Incorrect OS_TASK_RUNTIME value! Runtime accounting is not available for this port.
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 #ifndef OS_MAIN_PRIO
 #define OS_MAIN_PRIO          0 /* priority of main process                   */
 #endif
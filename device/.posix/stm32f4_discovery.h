@@ -0,0 +1,134 @@
+/******************************************************************************
+ * @file    stm32f4_discovery.h
+ * @author  Rajmund Szymanski
+ * @date    10.10.2018
+ * @brief   This file contains definitions for STM32F4-Discovery Kit emulated in the POSIX hosted environment.
+ ******************************************************************************/
+
+#ifndef __STM32F4_DISCOVERY_H
+#define __STM32F4_DISCOVERY_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif//__cplusplus
+
+/* -------------------------------------------------------------------------- */
+
+// there are no peripherals in the hosted environment
+// leds and button are emulated with variables of the process
+struct __board
+{
+	unsigned led[4];
+	unsigned leds: 4;
+	unsigned grn;
+	unsigned btn;
+};
+
+static volatile struct __board __board __attribute__((unused));
+
+/* -------------------------------------------------------------------------- */
+
+#define GRN  __board.grn     // usb green led
+#define LED  __board.led     // leds array
+#define LEDG __board.led[0]  // green led
+#define LEDO __board.led[1]  // orange led
+#define LEDR __board.led[2]  // red led
+#define LEDB __board.led[3]  // blue led
+
+#define LEDs __board.leds
+
+#define BTN  __board.btn     // user button
+
+/* -------------------------------------------------------------------------- */
+// init usb green led
+static inline
+void GRN_Init( void )
+{
+	GRN = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+// init leds
+static inline
+void LED_Init( void )
+{
+	LEDs = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+// rotate leds
+static inline
+void LED_Tick( void )
+{
+	unsigned leds = (LEDs << 1) & 0xE;
+	LEDs = leds ? leds : 0x1;
+}
+
+/* -------------------------------------------------------------------------- */
+// init user button
+static inline
+void BTN_Init( void )
+{
+	BTN = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef  __cplusplus
+}
+#endif//__cplusplus
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef  __cplusplus
+
+/* -------------------------------------------------------------------------- */
+
+class GreenLed
+{
+public:
+
+	GreenLed( void ) { GRN_Init(); }
+
+	operator   unsigned & ( void )                  { return (unsigned &)GRN; }
+	unsigned   operator = ( const unsigned status ) { GRN = status; return status; }
+	unsigned   operator ! ( void ) /* ++grn */      { return   GRN ^ 1U; }
+	unsigned   operator ++( void ) /* ++grn */      { unsigned grn = GRN + 1; GRN = grn; return grn; }
+	unsigned   operator ++( int  ) /* grn++ */      { unsigned grn = GRN; GRN = grn + 1; return grn; }
+};
+
+/* -------------------------------------------------------------------------- */
+
+class Led
+{
+	unsigned get( void )            { return LEDs; }
+	void     set( unsigned status ) { LEDs = status & 0xF; }
+
+public:
+
+	Led( void ) { LED_Init(); }
+
+	unsigned & operator []( const unsigned number ) { return (unsigned &)LED[number]; }
+	unsigned   operator = ( const unsigned status ) {                              set(status); return status & 0xF; }
+	unsigned   operator ++( void ) /* ++led */      { unsigned status = get() + 1; set(status); return status & 0xF; }
+	unsigned   operator ++( int  ) /* led++ */      { unsigned status = get(); set(status + 1); return status; }
+
+	void tick( void ) { LED_Tick(); }
+};
+
+/* -------------------------------------------------------------------------- */
+
+class Button
+{
+public:
+
+	Button( void ) { BTN_Init(); }
+
+	unsigned operator ()( void ) { return BTN; }
+};
+
+/* -------------------------------------------------------------------------- */
+
+#endif//__cplusplus
+
+#endif//__STM32F4_DISCOVERY_H
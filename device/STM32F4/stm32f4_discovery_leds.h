@@ -78,10 +78,10 @@ public:
 	GreenLed( void ) { GRN_Init(); }
 
 	operator   unsigned & ( void )                  { return (unsigned &)GRN; }
-	unsigned   operator = ( const unsigned status ) { return   GRN = status; }
+	unsigned   operator = ( const unsigned status ) { GRN = status; return status; }
 	unsigned   operator ! ( void ) /* ++grn */      { return   GRN ^ 1U; }
-	unsigned   operator ++( void ) /* ++grn */      { return ++GRN;   }
-	unsigned   operator ++( int  ) /* grn++ */      { return   GRN++; }
+	unsigned   operator ++( void ) /* ++grn */      { unsigned grn = GRN + 1; GRN = grn; return grn; }
+	unsigned   operator ++( int  ) /* grn++ */      { unsigned grn = GRN; GRN = grn + 1; return grn; }
 };
 
 /* -------------------------------------------------------------------------- */
@@ -373,7 +373,7 @@ public:
 
 	unsigned operator ()( void )                 { return              BITBAND(((GPIO_TypeDef *)gpio)->IDR)[pin]; }
 	operator unsigned & ( void )                 { return (unsigned &)(BITBAND(((GPIO_TypeDef *)gpio)->ODR)[pin]); }
-	unsigned operator = ( const unsigned value ) { return              BITBAND(((GPIO_TypeDef *)gpio)->ODR)[pin] = value; }
+	unsigned operator = ( const unsigned value ) {                     BITBAND(((GPIO_TypeDef *)gpio)->ODR)[pin] = value; return value; }
 };
 
 /* -------------------------------------------------------------------------- */
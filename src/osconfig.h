@@ -82,3 +82,180 @@
 // available values: 16, 32, 64
 // default value: 32
 #define OS_TIMER_SIZE        32
+
+// ----------------------------
+// number of priority levels of the tasks' ready queue
+// OS_PRIO_LEVELS == 0 => insertion into the ready queue searches the queue, time depends on the number of ready tasks
+// OS_PRIO_LEVELS >  0 => insertion into the ready queue uses bitmap of occupied priority levels, time is constant
+//                        tasks with priority greater than or equal to OS_PRIO_LEVELS-1 share the highest level
+// available values: 0..1024
+// default value: 0
+#define OS_PRIO_LEVELS        0
+
+// ----------------------------
+// number of slots of each level of the timers' wheel
+// OS_TIMER_WHEEL == 0 => insertion into the timers' queue searches the queue, time depends on the number of started timers
+// OS_TIMER_WHEEL >  0 => timers are placed into the wheel slots by their deadline, insertion and removal time is constant
+// available values: 0, 2, 4, 8, ... 1024
+// default value: 0
+#define OS_TIMER_WHEEL        0
+
+// ----------------------------
+// number of levels of the timers' wheel, used when OS_TIMER_WHEEL > 0
+// OS_TIMER_LEVELS == 1 => hashed wheel, every slot is visited once per OS_TIMER_WHEEL ticks
+// OS_TIMER_LEVELS >  1 => hierarchical wheel, every level has OS_TIMER_WHEEL times coarser slots than the previous one
+//                         suitable for the tick-less mode, where slots are visited only if they are occupied
+//                         OS_TIMER_WHEEL ** OS_TIMER_LEVELS must be less than the range of the system timer counter
+// available values: 1..8
+// default value: 1
+#define OS_TIMER_LEVELS       1
+
+// ----------------------------
+// number of (virtual) processors
+// OS_CPU_COUNT == 1 => uniprocessor system
+// OS_CPU_COUNT >  1 => every processor has its own system data and tasks' ready queue, tasks are bound to processors
+//                      kernel data is protected by the system spin lock, only the hosted (posix) port is supported
+//                      all processors take the same lock (port_sys_lck) for every kernel service and every task switch,
+//                      so this is functional SMP: tasks run in parallel between kernel calls, but kernel services
+//                      do not scale with the number of processors (the scaling has not been measured on a multi-core host)
+// available values: 1..32
+// default value: 1
+#define OS_CPU_COUNT          1
+
+// ----------------------------
+// virtual time of the system timer
+// OS_VIRTUAL_TIME == 0 => system timer follows the host clock
+// OS_VIRTUAL_TIME >  0 => system timer is a virtual counter, the idle process moves it directly to the nearest timeout
+//                         os works in tick-less mode without round-robin preemption, results are repeatable
+//                         only the hosted (posix) port with OS_CPU_COUNT == 1 is supported
+// default value: 0
+#define OS_VIRTUAL_TIME       0
+
+// ----------------------------
+// dynamic tick of the system timer, used when the os does not work in tick-less mode
+// OS_DYNAMIC_TICK == 0 => system timer interrupts are generated with frequency OS_FREQUENCY
+// OS_DYNAMIC_TICK >  0 => system timer interrupts are suppressed by the idle process until the nearest timer event
+//                         also enables osKernelSuspend / osKernelResume of the cmsis-rtos2 api
+// default value: 0
+#define OS_DYNAMIC_TICK       0
+
+// ----------------------------
+// runtime accounting of tasks
+// OS_TASK_RUNTIME == 0 => tasks' runtime is not counted
+// OS_TASK_RUNTIME >  0 => processor time used by every task (and by the idle process) is counted at each context switch
+//                         with the processor cycle counter if provided by the port, otherwise with the system timer
+// default value: 0
+#define OS_TASK_RUNTIME       0
+
+// ----------------------------
+// trace recorder of the kernel events
+// OS_TRACE == 0 => trace recorder is disabled
+// OS_TRACE >  0 => number of records in the trace ring buffer (must be a power of 2)
+//                  context switches, wakeups, blockings and timer expiries are recorded
+//                  use .tools/trace2json to convert a dump of the buffer to the chrome trace format
+// default value: 0
+#define OS_TRACE              0
+
+// ----------------------------
+// earliest deadline first scheduling band
+// OS_EDF_PRIO == 0 => all tasks are scheduled according to their fixed priorities
+// OS_EDF_PRIO >  0 => ready tasks with priority OS_EDF_PRIO are ordered by their absolute deadlines
+//                     (set with tsk_setDeadline or by tsk_sleepNext to the end of the next period)
+//                     tasks with higher and lower priorities keep fixed-priority scheduling
+// default value: 0
+#define OS_EDF_PRIO           0
+
+// ----------------------------
+// processor budget reservations
+// OS_BUDGET == 0 => budget reservations are disabled
+// OS_BUDGET >  0 => tasks attached to a budget reservation share the processor time granted in every replenishment period
+//                   after exhausting the budget the tasks are demoted to the background priority of the reservation
+//                   until the next replenishment; requires the system timer working in tick mode (HW_TIMER_SIZE == 0)
+// default value: 0
+#define OS_BUDGET             0
+
+// ----------------------------
+// shared stack of basic tasks (in bytes)
+// OS_BASIC_STACK == 0 => basic tasks are disabled
+// OS_BASIC_STACK >  0 => size of the stack shared by the basic tasks with the same priority (created with bsc_init / bsc_create)
+//                        a basic task runs its state function to completion and has no stack of its own
+//                        every blocking call ends the invocation; the state function is started again after the task is resumed
+//                        when the state function returns, the next basic task on the same stack is started without the context switch
+// default value: 0
+#define OS_BASIC_STACK        0
+
+// ----------------------------
+// timer daemon
+// OS_TIMER_DAEMON == 0 => callbacks of all timers are executed in the timer interrupt
+// OS_TIMER_DAEMON >  0 => priority of the timer daemon task; callbacks of the timers set with tmr_setDeferred
+//                         (and of the CMSIS and OSAL timers) are executed by the daemon in thread mode,
+//                         the timer interrupt only queues the expired timers
+// default value: 0
+#define OS_TIMER_DAEMON       0
+
+// ----------------------------
+// slack of timers and timeouts
+// OS_TIMER_SLACK == 0 => timers and timeouts expire exactly at their deadlines
+// OS_TIMER_SLACK == 1 => every timer and task may have a slack (tmr_setSlack, tsk_setSlack): a tolerated delay of its expiration
+//                        expirations with overlapping windows are served together in one pass of the timer handler,
+//                        which reduces the number of timer interrupts and wakeups
+// default value: 0
+#define OS_TIMER_SLACK        0
+
+// ----------------------------
+// monotonic clock in nanoseconds
+// OS_TIME_NSEC == 0 => sys_timeNs is not available
+// OS_TIME_NSEC == 1 => sys_timeNs: 64-bit monotonic clock interpolated with the runtime counter (processor cycle counter
+//                      on Cortex-M3 and above, host clock on posix, system timer counter otherwise);
+//                      it is read without any critical section and may be used in every interrupt handler
+// default value: 0
+#define OS_TIME_NSEC          0
+
+// ----------------------------
+// bounded time of the kernel critical sections
+// OS_LOCK_SPAN == 0 => kernel loops (broadcast wakeup, scan of the flags waiters, stream buffer transfer, heap walk,
+//                      destruction of tasks) are executed in one critical section, its time depends on the number of items
+// OS_LOCK_SPAN >  0 => number of iterations after which the kernel loop briefly restores the interrupts state saved
+//                      at the entry to the service; task switching is deferred for the time of the window
+//                      requires a single processor (OS_CPU_COUNT == 1)
+// default value: 0
+#define OS_LOCK_SPAN          0
+
+// ----------------------------
+// statistics of the kernel critical sections
+// OS_LOCK_STATS == 0 => statistics are disabled
+// OS_LOCK_STATS == 1 => the longest time of the critical section is recorded for every bounded kernel loop (sys_getLockHold)
+// default value: 0
+#define OS_LOCK_STATS         0
+
+// ----------------------------
+// deferred service routines (threaded interrupt handlers)
+// OS_DSR_LEVELS == 0 => deferred service routines are disabled
+// OS_DSR_LEVELS >  0 => number of priority levels of the deferred service routines
+//                       routines posted by the interrupt handlers (dsr_giveISR) are executed in thread mode
+//                       by the worker task of their level; all routines of the level share the stack of the worker
+// default value: 0
+#define OS_DSR_LEVELS         0
+
+// ----------------------------
+// priority of the worker task of the lowest level of the deferred service routines
+// the worker of level 'n' has the priority OS_DSR_PRIO + n; it should be higher than the priorities of the application tasks
+// default value: 1
+#define OS_DSR_PRIO           1
+
+// ----------------------------
+// lock-free give from the interrupt handlers
+// OS_ISR_LOCKFREE == 0 => sem_giveISR, flg_giveISR, tsk_giveISR and tsk_notifyISR are aliases of the thread mode functions
+// OS_ISR_LOCKFREE == 1 => sem_giveISR, flg_giveISR, tsk_giveISR and tsk_notifyISR record the post atomically in the object,
+//                         without disabling the interrupts; the post is resolved by the kernel handler after the interrupt
+// default value: 0
+#define OS_ISR_LOCKFREE       0
+
+// ----------------------------
+// task notifications
+// OS_TSK_NOTIFY == 0 => task notifications are disabled
+// OS_TSK_NOTIFY >  0 => number of 32-bit notification slots of every task (tsk_notify, tsk_notifyWait)
+//                       the waiting task is released directly by the notifier, no wait queue is shared;
+//                       thread flags of the CMSIS-RTOS2 wrapper are kept in the slot 0
+// default value: 0
+#define OS_TSK_NOTIFY         0